@@ -0,0 +1,28 @@
+# Generates a C++ source defining files as byte arrays, to be found at run time with findAsset (see src/assets.hpp).
+#
+# Usage : cmake -DASSET_ROOT=<dir> -DASSET_FILES=<names relative to the root> -DASSET_OUTPUT=<file> -P EmbedAssets.cmake
+
+set(source "// Generated by cmake/EmbedAssets.cmake, do not edit.\n\n#include \"assets.hpp\"\n\n")
+set(table "")
+set(index 0)
+
+foreach(name IN LISTS ASSET_FILES)
+    file(READ "${ASSET_ROOT}/${name}" hex HEX)
+    string(LENGTH "${hex}" length)
+    math(EXPR size "${length} / 2")
+
+    # 16 bytes per line.
+    string(REPEAT "[0-9a-f]" 32 line)
+    string(REGEX REPLACE "(${line})" "\\1\n" hex "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+
+    string(APPEND source "static const unsigned char asset${index}[${size}] = {\n${bytes}\n};\n\n")
+    string(APPEND table "    {\"${name}\", asset${index}, ${size}},\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+string(APPEND source "const EmbeddedAsset embeddedAssets[] = {\n${table}};\n\nconst std::size_t embeddedAssetCount = ${index};\n")
+
+# Always rewritten, even when nothing changed, otherwise the output stays older than the assets and
+# the build keeps running this script.
+file(WRITE "${ASSET_OUTPUT}" "${source}")
@@ -0,0 +1,156 @@
+/******************************************************************************************************
+ * @file  BoardRenderer.cpp
+ * @brief Implementation of the BoardRenderer class
+ ******************************************************************************************************/
+
+#include "BoardRenderer.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include "assets.hpp"
+#include "graphics.hpp"
+
+/* FreeType doesn't allow faces to be opened or closed concurrently, rendering with separate fonts is fine. */
+static std::mutex fontMutex;
+
+BoardRenderer::BoardRenderer(SDL_Renderer* renderer, const RGB& whiteSquare, const RGB& blackSquare, PieceImages* images)
+    : renderer(renderer), font(), fontSize(20), textures(), chessBoard() {
+
+    {
+        std::lock_guard lock(fontMutex);
+        font = TTF_OpenFontRW(openAsset("fonts/courbd.ttf"), 1, fontSize);
+    }
+
+    if(!font) {
+        throw std::runtime_error(SDL_GetError());
+    }
+
+    /* The font and the textures created before a failure would be leaked otherwise. */
+    try {
+        std::optional<PieceImages> ownImages;
+        if(!images) {
+            images = &ownImages.emplace();
+        }
+
+        for(int piece = 0 ; piece < 6 ; ++piece) {
+            for(int color = 0 ; color < 2 ; ++color) {
+                SDL_Surface* surface = images->getSurface(ChessPiece(piece), ChessColor(color));
+                textures[piece][color] = createTextureFromSurface(renderer, surface, false);
+            }
+        }
+
+        RGB pixels[8][8];
+        for(int i = 0 ; i < 8 ; ++i) {
+            for(int j = 0 ; j < 8 ; ++j) {
+                pixels[i][j] = ((i + j) % 2) ? blackSquare : whiteSquare;
+            }
+        }
+
+        Uint32 Rmask, Gmask, Bmask, Amask;
+        int bpp;
+        SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_RGB24, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
+
+        chessBoard = createTextureFromSurface(renderer, SDL_CreateRGBSurfaceFrom(pixels, 8, 8, bpp, 8 * 3, Rmask, Gmask, Bmask, Amask));
+    } catch(...) {
+        release();
+        throw;
+    }
+}
+
+BoardRenderer::~BoardRenderer() {
+    release();
+}
+
+void BoardRenderer::release() {
+    for(auto& piece: textures) {
+        for(auto& texture: piece) {
+            if(texture) {
+                SDL_DestroyTexture(texture);
+                texture = nullptr;
+            }
+        }
+    }
+
+    if(chessBoard) {
+        SDL_DestroyTexture(chessBoard);
+        chessBoard = nullptr;
+    }
+
+    std::lock_guard lock(fontMutex);
+    TTF_CloseFont(font);
+    font = nullptr;
+}
+
+void BoardRenderer::fitSurface(const Rect& area) {
+    boardSurface.w = std::min(area.w, area.h) * 0.8f;
+    boardSurface.h = boardSurface.w;
+    boardSurface.x = area.x + (area.w - boardSurface.w) / 2;
+    boardSurface.y = area.y + (area.h - boardSurface.h) / 2;
+
+    /* Changing the size flushes the font's glyph cache, which matters when many boards share the font. */
+    const int size = boardSurface.w / 32;
+    if(size != fontSize) {
+        fontSize = size;
+        TTF_SetFontSize(font, fontSize);
+    }
+}
+
+const Rect& BoardRenderer::getSurface() const {
+    return boardSurface;
+}
+
+TTF_Font* BoardRenderer::getFont() const {
+    return font;
+}
+
+int BoardRenderer::getFontSize() const {
+    return fontSize;
+}
+
+SDL_Texture* BoardRenderer::getTexture(const ChessSquare& square) const {
+    return textures[square.piece][square.color];
+}
+
+void BoardRenderer::drawBoard() const {
+    SDL_RenderCopy(renderer, chessBoard, nullptr, &boardSurface);
+}
+
+void BoardRenderer::drawPieces(const ChessBoard& board) const {
+    SDL_Rect surface = boardSurface;
+
+    surface.w /= 8;
+    surface.h /= 8;
+
+    for(int i = 0 ; i < 8 ; ++i) {
+        for(int j = 0 ; j < 8 ; ++j) {
+            const ChessSquare& square = board[i][j];
+
+            if(square.piece != ChessPieceNone) {
+                SDL_RenderCopy(renderer, textures[square.piece][square.color], nullptr, &surface);
+            }
+
+            surface.x += surface.w;
+        }
+
+        surface.x = boardSurface.x;
+        surface.y += surface.h;
+    }
+}
+
+void BoardRenderer::drawLettersAndNumbers() const {
+    int squareSize = boardSurface.w / 8;
+    Color color(255, 255, 255);
+    Rect rect;
+    std::string letters = "ABCDEFGH";
+
+    for(int i = 0 ; i < 8 ; ++i) {
+        rect = Rect(boardSurface.x - squareSize + squareSize / 2, boardSurface.y + squareSize * i, squareSize - squareSize / 2, squareSize);
+        renderCenteredText(renderer, font, rect, color, std::to_string(8 - i));
+
+        rect = Rect(boardSurface.x + squareSize * i, boardSurface.y + squareSize * 8, squareSize, squareSize - squareSize / 2);
+        renderCenteredText(renderer, font, rect, color, letters.substr(i, 1));
+    }
+}
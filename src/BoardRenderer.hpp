@@ -0,0 +1,65 @@
+/******************************************************************************************************
+ * @file  BoardRenderer.hpp
+ * @brief Definition of the BoardRenderer class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include "ChessBoard.hpp"
+#include "Color.hpp"
+#include "PieceImages.hpp"
+#include "Rect.hpp"
+#include "Point.hpp"
+
+/**
+ * @class BoardRenderer
+ * @brief Owns the piece textures and font needed to draw a chess board with a given SDL_Renderer,
+ * which can either be a window's renderer or a software renderer drawing to an offscreen surface.
+ */
+class BoardRenderer {
+private:
+    SDL_Renderer* renderer;
+
+    TTF_Font* font;
+    int fontSize;
+
+    Rect boardSurface;
+
+    SDL_Texture* textures[6][2];
+    SDL_Texture* chessBoard;
+
+    void release();
+
+public:
+    /**
+     * @param renderer The renderer the textures are created for and drawn with
+     * @param whiteSquare The color of the white squares
+     * @param blackSquare The color of the black squares
+     * @param images Images of the pieces decoded beforehand, when nullptr they are decoded here
+     */
+    BoardRenderer(SDL_Renderer* renderer, const RGB& whiteSquare, const RGB& blackSquare, PieceImages* images = nullptr);
+    ~BoardRenderer();
+
+    BoardRenderer(const BoardRenderer&) = delete;
+    BoardRenderer& operator=(const BoardRenderer&) = delete;
+
+    /**
+     * @brief Centers the board in an area, making it take 80% of the area's smallest side, and
+     * adapts the font size to it.
+     *
+     * @param area The area the board is drawn in
+     */
+    void fitSurface(const Rect& area);
+
+    const Rect& getSurface() const;
+    TTF_Font* getFont() const;
+    int getFontSize() const;
+    SDL_Texture* getTexture(const ChessSquare& square) const;
+
+    void drawBoard() const;
+    void drawPieces(const ChessBoard& board) const;
+    void drawLettersAndNumbers() const;
+};
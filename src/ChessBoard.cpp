@@ -0,0 +1,421 @@
+/******************************************************************************************************
+ * @file  ChessBoard.cpp
+ * @brief Implementation of the ChessBoard class
+ ******************************************************************************************************/
+
+#include "ChessBoard.hpp"
+
+#include <stdexcept>
+#include "bitboards.hpp"
+
+/* Zobrist keys, indexed by piece, color and square, plus one key for black to move. */
+static constexpr auto zobristKeys = [] {
+    std::array<uint64_t, 6 * 2 * 64 + 1> keys{};
+    uint64_t state = 0x9E3779B97F4A7C15;
+
+    for(uint64_t& key: keys) {
+        state += 0x9E3779B97F4A7C15;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        key = z ^ (z >> 31);
+    }
+
+    return keys;
+}();
+
+std::string ChessMove::toString() const {
+    return {char('a' + from % 8), char('8' - from / 8), char('a' + to % 8), char('8' - to / 8)};
+}
+
+ChessBoard::ChessBoard() : turn(ChessColorWhite) {
+    setStartingPosition();
+}
+
+void ChessBoard::setStartingPosition() {
+    const ChessPiece boardInit[8]{
+        ChessPieceRook, ChessPieceKnight, ChessPieceBishop, ChessPieceQueen,
+        ChessPieceKing, ChessPieceBishop, ChessPieceKnight, ChessPieceRook
+    };
+
+    for(int i = 0 ; i < 8 ; ++i) {
+        for(int j = 0 ; j < 8 ; ++j) {
+            switch(i) {
+                case 0:
+                    squares[i][j] = ChessSquare(boardInit[j], ChessColorBlack);
+                    break;
+                case 1:
+                    squares[i][j] = ChessSquare(ChessPiecePawn, ChessColorBlack);
+                    break;
+                case 6:
+                    squares[i][j] = ChessSquare(ChessPiecePawn, ChessColorWhite);
+                    break;
+                case 7:
+                    squares[i][j] = ChessSquare(boardInit[j], ChessColorWhite);
+                    break;
+                default:
+                    squares[i][j] = ChessSquare(ChessPieceNone, ChessColorWhite);
+                    break;
+            }
+        }
+    }
+
+    turn = ChessColorWhite;
+}
+
+void ChessBoard::loadFEN(const std::string& fen) {
+    ChessSquare loaded[8][8];
+    int row = 0, column = 0;
+    std::size_t i = 0;
+
+    for(auto& line: loaded) {
+        for(auto& square: line) {
+            square = ChessSquare(ChessPieceNone, ChessColorWhite);
+        }
+    }
+
+    for(; i < fen.size() && fen[i] != ' ' ; ++i) {
+        const char c = fen[i];
+
+        if(c == '/') {
+            if(column != 8 || ++row >= 8) {
+                throw std::runtime_error("Invalid FEN : wrong number of squares in '" + fen + "'");
+            }
+
+            column = 0;
+        } else if(c >= '1' && c <= '8') {
+            column += c - '0';
+        } else {
+            ChessPiece piece;
+
+            switch(c | 0x20) {
+                case 'k': piece = ChessPieceKing; break;
+                case 'q': piece = ChessPieceQueen; break;
+                case 'b': piece = ChessPieceBishop; break;
+                case 'n': piece = ChessPieceKnight; break;
+                case 'r': piece = ChessPieceRook; break;
+                case 'p': piece = ChessPiecePawn; break;
+                default:
+                    throw std::runtime_error("Invalid FEN : unknown piece '" + std::string(1, c) + "' in '" + fen + "'");
+            }
+
+            if(column >= 8) {
+                throw std::runtime_error("Invalid FEN : wrong number of squares in '" + fen + "'");
+            }
+
+            loaded[row][column++] = ChessSquare(piece, (c & 0x20) ? ChessColorBlack : ChessColorWhite);
+        }
+
+        if(column > 8) {
+            throw std::runtime_error("Invalid FEN : wrong number of squares in '" + fen + "'");
+        }
+    }
+
+    if(row != 7 || column != 8) {
+        throw std::runtime_error("Invalid FEN : wrong number of squares in '" + fen + "'");
+    }
+
+    ChessColor loadedTurn = ChessColorWhite;
+    if(i + 1 < fen.size()) {
+        switch(fen[i + 1]) {
+            case 'w': loadedTurn = ChessColorWhite; break;
+            case 'b': loadedTurn = ChessColorBlack; break;
+            default:
+                throw std::runtime_error("Invalid FEN : unknown active color in '" + fen + "'");
+        }
+    }
+
+    for(int x = 0 ; x < 8 ; ++x) {
+        for(int y = 0 ; y < 8 ; ++y) {
+            squares[x][y] = loaded[x][y];
+        }
+    }
+
+    turn = loadedTurn;
+}
+
+bool ChessBoard::testMoves(const ChessSquare& piece, const Point& from, const Point& target) const {
+    switch(piece.piece) {
+        case ChessPieceKing:
+            return movesKing(from, target);
+        case ChessPieceQueen:
+            return movesQueen(from, target);
+        case ChessPieceBishop:
+            return movesBishop(from, target);
+        case ChessPieceKnight:
+            return movesKnight(from, target);
+        case ChessPieceRook:
+            return movesRook(from, target);
+        case ChessPiecePawn:
+            return movesPawn(from, target);
+        default:
+            return false;
+    }
+}
+
+bool ChessBoard::movesKing(const Point& from, const Point& target) const {
+    return kingAttacks[square(from.x, from.y)] & squareMask(square(target.x, target.y));
+}
+
+bool ChessBoard::movesQueen(const Point& from, const Point& target) const {
+    return movesBishop(from, target) || movesRook(from, target);
+}
+
+bool ChessBoard::movesBishop(const Point& from, const Point& target) const {
+    const int origin = square(from.x, from.y);
+    const int to = square(target.x, target.y);
+
+    return (bishopMasks[origin] & squareMask(to)) && isPathClear(origin, to);
+}
+
+bool ChessBoard::movesKnight(const Point& from, const Point& target) const {
+    return knightAttacks[square(from.x, from.y)] & squareMask(square(target.x, target.y));
+}
+
+bool ChessBoard::movesRook(const Point& from, const Point& target) const {
+    const int origin = square(from.x, from.y);
+    const int to = square(target.x, target.y);
+
+    return (rookMasks[origin] & squareMask(to)) && isPathClear(origin, to);
+}
+
+bool ChessBoard::movesPawn(const Point& from, const Point& target) const {
+    const int origin = square(from.x, from.y);
+    const Bitboard to = squareMask(square(target.x, target.y));
+
+    if(pawnPushes[turn][origin] & to) {
+        return squares[target.x][target.y].piece == ChessPieceNone;
+    } else if(pawnAttacks[turn][origin] & to) {
+        return squares[target.x][target.y].piece != ChessPieceNone;
+    }
+
+    if(pawnDoublePushes[turn][origin] & to) {
+        return squares[target.x][target.y].piece == ChessPieceNone && squares[(from.x + target.x) / 2][from.y].piece == ChessPieceNone;
+    }
+
+    return false;
+}
+
+bool ChessBoard::isPathClear(int from, int to) const {
+    for(Bitboard path = betweenMasks[from][to] ; path ; path &= path - 1) {
+        const int sq = firstSquare(path);
+
+        if(squares[sq / 8][sq % 8].piece != ChessPieceNone) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ChessUndo ChessBoard::makeMove(const ChessMove& move) {
+    ChessSquare& from = squares[move.from / 8][move.from % 8];
+    ChessSquare& to = squares[move.to / 8][move.to % 8];
+    const ChessUndo undo{from, to};
+
+    to = from;
+    if(to.piece == ChessPiecePawn && (move.to / 8 == 0 || move.to / 8 == 7)) {
+        to.piece = ChessPieceQueen;
+    }
+
+    from = ChessSquare(ChessPieceNone, ChessColorWhite);
+    nextTurn();
+
+    return undo;
+}
+
+void ChessBoard::unmakeMove(const ChessMove& move, const ChessUndo& undo) {
+    squares[move.from / 8][move.from % 8] = undo.moved;
+    squares[move.to / 8][move.to % 8] = undo.captured;
+    nextTurn();
+}
+
+void ChessBoard::generateMoves(std::vector<ChessMove>& moves, bool capturesOnly) const {
+    const auto addTargets = [&](int from, Bitboard targets) {
+        for(; targets ; targets &= targets - 1) {
+            const int to = firstSquare(targets);
+            const ChessSquare& target = squares[to / 8][to % 8];
+
+            if(target.piece == ChessPieceNone ? !capturesOnly : target.color != turn) {
+                moves.push_back(ChessMove{(unsigned char) from, (unsigned char) to});
+            }
+        }
+    };
+
+    for(int from = 0 ; from < 64 ; ++from) {
+        const ChessSquare& piece = squares[from / 8][from % 8];
+
+        if(piece.piece == ChessPieceNone || piece.color != turn) {
+            continue;
+        }
+
+        switch(piece.piece) {
+            case ChessPieceKing:
+                addTargets(from, kingAttacks[from]);
+                break;
+            case ChessPieceKnight:
+                addTargets(from, knightAttacks[from]);
+                break;
+            case ChessPiecePawn: {
+                Bitboard targets = 0;
+
+                for(Bitboard attacks = pawnAttacks[turn][from] ; attacks ; attacks &= attacks - 1) {
+                    const int to = firstSquare(attacks);
+                    if(squares[to / 8][to % 8].piece != ChessPieceNone) {
+                        targets |= squareMask(to);
+                    }
+                }
+
+                if(!capturesOnly && pawnPushes[turn][from]) {
+                    const int to = firstSquare(pawnPushes[turn][from]);
+
+                    if(squares[to / 8][to % 8].piece == ChessPieceNone) {
+                        targets |= pawnPushes[turn][from];
+
+                        const Bitboard doublePush = pawnDoublePushes[turn][from];
+                        if(doublePush && squares[firstSquare(doublePush) / 8][from % 8].piece == ChessPieceNone) {
+                            targets |= doublePush;
+                        }
+                    }
+                }
+
+                addTargets(from, targets);
+                break;
+            }
+            default: {
+                /* Bishops use the diagonal rayDirections, rooks the orthogonal ones and queens all of them. */
+                const int first = piece.piece == ChessPieceRook ? 4 : 0;
+                const int last = piece.piece == ChessPieceBishop ? 4 : 8;
+                Bitboard targets = 0;
+
+                for(int direction = first ; direction < last ; ++direction) {
+                    const Offset& offset = rayDirections[direction];
+
+                    for(int x = from / 8 + offset.x, y = from % 8 + offset.y ; isOnBoard(x, y) ; x += offset.x, y += offset.y) {
+                        targets |= squareMask(square(x, y));
+
+                        if(squares[x][y].piece != ChessPieceNone) {
+                            break;
+                        }
+                    }
+                }
+
+                addTargets(from, targets);
+                break;
+            }
+        }
+    }
+}
+
+void ChessBoard::keepLegalMoves(std::vector<ChessMove>& moves, std::size_t first) const {
+    std::size_t kept = first;
+
+    for(std::size_t i = first ; i < moves.size() ; ++i) {
+        ChessBoard next = *this;
+        next.makeMove(moves[i]);
+
+        if(!next.isInCheck(turn)) {
+            moves[kept++] = moves[i];
+        }
+    }
+
+    moves.resize(kept);
+}
+
+void ChessBoard::generateLegalMoves(std::vector<ChessMove>& moves) const {
+    const std::size_t first = moves.size();
+
+    generateMoves(moves, false);
+    keepLegalMoves(moves, first);
+}
+
+void ChessBoard::generateLegalCaptures(std::vector<ChessMove>& moves) const {
+    const std::size_t first = moves.size();
+
+    generateMoves(moves, true);
+    keepLegalMoves(moves, first);
+}
+
+bool ChessBoard::isAttacked(int square, ChessColor attacker) const {
+    const auto hasPiece = [&](Bitboard candidates, ChessPiece piece) {
+        for(; candidates ; candidates &= candidates - 1) {
+            const ChessSquare& candidate = squares[firstSquare(candidates) / 8][firstSquare(candidates) % 8];
+
+            if(candidate.piece == piece && candidate.color == attacker) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    if(hasPiece(knightAttacks[square], ChessPieceKnight) || hasPiece(kingAttacks[square], ChessPieceKing)) {
+        return true;
+    }
+
+    /* A pawn attacks this square from the squares a pawn of the other color would attack from it. */
+    if(hasPiece(pawnAttacks[!attacker][square], ChessPiecePawn)) {
+        return true;
+    }
+
+    for(int direction = 0 ; direction < 8 ; ++direction) {
+        const Offset& offset = rayDirections[direction];
+        const ChessPiece slider = direction < 4 ? ChessPieceBishop : ChessPieceRook;
+
+        for(int x = square / 8 + offset.x, y = square % 8 + offset.y ; isOnBoard(x, y) ; x += offset.x, y += offset.y) {
+            const ChessSquare& blocker = squares[x][y];
+
+            if(blocker.piece != ChessPieceNone) {
+                if(blocker.color == attacker && (blocker.piece == slider || blocker.piece == ChessPieceQueen)) {
+                    return true;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ChessBoard::isInCheck(ChessColor color) const {
+    for(int sq = 0 ; sq < 64 ; ++sq) {
+        const ChessSquare& king = squares[sq / 8][sq % 8];
+
+        if(king.piece == ChessPieceKing && king.color == color) {
+            return isAttacked(sq, color ? ChessColorWhite : ChessColorBlack);
+        }
+    }
+
+    return false;
+}
+
+uint64_t ChessBoard::hash() const {
+    uint64_t hash = turn == ChessColorBlack ? zobristKeys.back() : 0;
+
+    for(int sq = 0 ; sq < 64 ; ++sq) {
+        const ChessSquare& square = squares[sq / 8][sq % 8];
+
+        if(square.piece != ChessPieceNone) {
+            hash ^= zobristKeys[(square.piece * 2 + square.color) * 64 + sq];
+        }
+    }
+
+    return hash;
+}
+
+ChessColor ChessBoard::getTurn() const {
+    return turn;
+}
+
+void ChessBoard::nextTurn() {
+    turn = turn ? ChessColorWhite : ChessColorBlack;
+}
+
+ChessSquare* ChessBoard::operator[](int row) {
+    return squares[row];
+}
+
+const ChessSquare* ChessBoard::operator[](int row) const {
+    return squares[row];
+}
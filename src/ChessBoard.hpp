@@ -0,0 +1,162 @@
+/******************************************************************************************************
+ * @file  ChessBoard.hpp
+ * @brief Definition of the ChessBoard class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Point.hpp"
+
+/**
+ * @enum ChessPiece
+ * @brief Represents the different pieces of a chess game
+ */
+enum ChessPiece : char {
+    ChessPieceKing,
+    ChessPieceQueen,
+    ChessPieceBishop,
+    ChessPieceKnight,
+    ChessPieceRook,
+    ChessPiecePawn,
+    ChessPieceNone
+};
+
+/**
+ * @enum ChessColor
+ * @brief Represents the different colors for the pieces of a chess game
+ */
+enum ChessColor : char {
+    ChessColorWhite,
+    ChessColorBlack,
+};
+
+/**
+ * @struct ChessSquare
+ * @brief Represents a square of the chess board
+ */
+struct ChessSquare {
+    ChessSquare() = default;
+    ChessSquare(ChessPiece piece, ChessColor color) : piece(piece), color(color) { }
+    ChessPiece piece;
+    ChessColor color;
+};
+
+/**
+ * @struct ChessMove
+ * @brief Represents a move between two squares, indexed as in bitboards.hpp (row * 8 + column)
+ */
+struct ChessMove {
+    unsigned char from, to;
+
+    /**
+     * @brief Returns the move in coordinate notation, e.g. "e2e4".
+     */
+    std::string toString() const;
+};
+
+/**
+ * @struct ChessUndo
+ * @brief Holds what ChessBoard::makeMove overwrote so the move can be taken back
+ */
+struct ChessUndo {
+    ChessSquare moved, captured;
+};
+
+/**
+ * @class ChessBoard
+ * @brief Holds the squares of a chess board and whose turn it is. Row 0 is the top of the board,
+ * where the black pieces start.
+ */
+class ChessBoard {
+private:
+    ChessSquare squares[8][8];
+    ChessColor turn;
+
+    bool isPathClear(int from, int to) const;
+    void generateMoves(std::vector<ChessMove>& moves, bool capturesOnly) const;
+    void keepLegalMoves(std::vector<ChessMove>& moves, std::size_t first) const;
+
+public:
+    ChessBoard();
+
+    /**
+     * @brief Puts every piece on its starting square and gives the turn to white.
+     */
+    void setStartingPosition();
+
+    /**
+     * @brief Loads the piece placement and active color fields of a FEN string. The remaining fields
+     * (castling, en passant and clocks) are ignored since the game doesn't handle them.
+     *
+     * @param fen The FEN string
+     *
+     * @throw std::runtime_error If the FEN string is malformed
+     */
+    void loadFEN(const std::string& fen);
+
+    /**
+     * @brief Tests whether a piece can move between two squares, according to the color whose turn
+     * it is. The origin square is expected to be empty since the piece is lifted from the board while
+     * it is being moved.
+     *
+     * @param piece The piece being moved
+     * @param from The square the piece comes from
+     * @param target The square the piece goes to
+     *
+     * @return Whether the move is allowed
+     */
+    bool testMoves(const ChessSquare& piece, const Point& from, const Point& target) const;
+    bool movesKing(const Point& from, const Point& target) const;
+    bool movesQueen(const Point& from, const Point& target) const;
+    bool movesBishop(const Point& from, const Point& target) const;
+    bool movesKnight(const Point& from, const Point& target) const;
+    bool movesRook(const Point& from, const Point& target) const;
+    bool movesPawn(const Point& from, const Point& target) const;
+
+    /**
+     * @brief Plays a move, promoting pawns reaching the last row to queens, and gives the turn to the
+     * other color. The move isn't checked.
+     *
+     * @param move The move to play
+     *
+     * @return What is needed to take the move back with unmakeMove
+     */
+    ChessUndo makeMove(const ChessMove& move);
+
+    /**
+     * @brief Takes back a move played with makeMove.
+     */
+    void unmakeMove(const ChessMove& move, const ChessUndo& undo);
+
+    /**
+     * @brief Generates every move of the color whose turn it is that doesn't leave its own king in
+     * check. Castling and en passant aren't handled since the game doesn't allow them.
+     *
+     * @param moves The moves are appended to this vector
+     */
+    void generateLegalMoves(std::vector<ChessMove>& moves) const;
+
+    /**
+     * @brief Generates the captures among the legal moves.
+     *
+     * @param moves The moves are appended to this vector
+     */
+    void generateLegalCaptures(std::vector<ChessMove>& moves) const;
+
+    bool isAttacked(int square, ChessColor attacker) const;
+    bool isInCheck(ChessColor color) const;
+
+    /**
+     * @brief Returns the Zobrist hash of the position, including whose turn it is.
+     */
+    uint64_t hash() const;
+
+    ChessColor getTurn() const;
+    void nextTurn();
+
+    ChessSquare* operator[](int row);
+    const ChessSquare* operator[](int row) const;
+};
@@ -0,0 +1,340 @@
+/******************************************************************************************************
+ * @file  ChessEngine.cpp
+ * @brief Implementation of the ChessEngine class
+ ******************************************************************************************************/
+
+#include "ChessEngine.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <stdexcept>
+
+enum TableBound : unsigned char {
+    TableBoundExact,
+    TableBoundLower,
+    TableBoundUpper
+};
+
+/* Indexed by ChessPiece. */
+static constexpr int pieceValues[6]{0, 900, 330, 320, 500, 100};
+
+/**
+ * @brief Mate scores are stored relative to the node they were found at rather than to the root.
+ */
+static int toTable(int score, int ply) {
+    if(score >= ChessEngine::mateScore - 2 * ChessEngine::maxDepth) {
+        return score + ply;
+    } else if(score <= -ChessEngine::mateScore + 2 * ChessEngine::maxDepth) {
+        return score - ply;
+    }
+
+    return score;
+}
+
+static int fromTable(int score, int ply) {
+    if(score >= ChessEngine::mateScore - 2 * ChessEngine::maxDepth) {
+        return score - ply;
+    } else if(score <= -ChessEngine::mateScore + 2 * ChessEngine::maxDepth) {
+        return score + ply;
+    }
+
+    return score;
+}
+
+ChessEngine::ChessEngine(std::size_t tableSize)
+    : table(std::bit_floor(std::max(tableSize, std::size_t(1)))), nodes(0), nodeLimit(0), stopFlag(nullptr), aborted(false) {
+
+    for(std::vector<ChessMove>& moves: moveLists) {
+        moves.reserve(256);
+    }
+
+    clear();
+}
+
+void ChessEngine::clear() {
+    std::fill(table.begin(), table.end(), TableEntry{0, {0, 0}, 0, -1, TableBoundExact});
+}
+
+void ChessEngine::setNodeLimit(uint64_t limit) {
+    nodeLimit = limit;
+}
+
+uint64_t ChessEngine::perft(const ChessBoard& board, int depth, const std::atomic<bool>* stop) {
+    if(depth <= 0) {
+        return 1;
+    }
+
+    ChessBoard position = board;
+
+    nodes = 0;
+    stopFlag = stop;
+    aborted = false;
+
+    const uint64_t leaves = perft(position, std::min(depth, maxPly), 0);
+    stopFlag = nullptr;
+
+    if(aborted) {
+        throw std::runtime_error("perft stopped before completing");
+    }
+
+    return leaves;
+}
+
+uint64_t ChessEngine::perft(ChessBoard& board, int depth, int ply) {
+    if(shouldStop()) {
+        return 0;
+    }
+
+    ++nodes;
+
+    std::vector<ChessMove>& moves = moveLists[ply];
+    moves.clear();
+    board.generateLegalMoves(moves);
+
+    if(depth == 1) {
+        return moves.size();
+    }
+
+    uint64_t leaves = 0;
+    for(const ChessMove& move: moves) {
+        const ChessUndo undo = board.makeMove(move);
+        leaves += perft(board, depth - 1, ply + 1);
+        board.unmakeMove(move, undo);
+    }
+
+    return leaves;
+}
+
+int ChessEngine::evaluate(const ChessBoard& board) const {
+    int score = 0;
+
+    for(int x = 0 ; x < 8 ; ++x) {
+        for(int y = 0 ; y < 8 ; ++y) {
+            const ChessSquare& square = board[x][y];
+            if(square.piece == ChessPieceNone) {
+                continue;
+            }
+
+            /* 3 on the four central squares down to 0 on the edges. */
+            const int centrality = 3 - std::max(std::abs(2 * x - 7), std::abs(2 * y - 7)) / 2;
+            int value = pieceValues[square.piece];
+
+            switch(square.piece) {
+                case ChessPieceKnight:
+                case ChessPieceBishop:
+                    value += 10 * centrality;
+                    break;
+                case ChessPieceQueen:
+                    value += 3 * centrality;
+                    break;
+                case ChessPiecePawn:
+                    value += 5 * (square.color == ChessColorWhite ? 6 - x : x - 1) + 5 * centrality;
+                    break;
+                case ChessPieceKing:
+                    value -= 10 * centrality;
+                    break;
+                default:
+                    break;
+            }
+
+            score += square.color == ChessColorWhite ? value : -value;
+        }
+    }
+
+    return board.getTurn() == ChessColorWhite ? score : -score;
+}
+
+SearchResult ChessEngine::search(const ChessBoard& board, int depth, const std::atomic<bool>* stop) {
+    SearchResult result{{0, 0}, false, 0, 0, 0};
+    ChessBoard root = board;
+    std::vector<ChessMove> rootMoves;
+
+    nodes = 0;
+    stopFlag = stop;
+    aborted = false;
+    root.generateLegalMoves(rootMoves);
+
+    if(rootMoves.empty()) {
+        result.score = root.isInCheck(root.getTurn()) ? -mateScore : 0;
+        return result;
+    }
+
+    result.hasMove = true;
+    result.bestMove = rootMoves[0];
+
+    for(int iteration = 1 ; iteration <= std::min(depth, maxDepth) ; ++iteration) {
+        orderMoves(root, rootMoves, &result.bestMove);
+
+        int alpha = -mateScore - 1;
+        ChessMove bestMove = rootMoves[0];
+
+        for(const ChessMove& move: rootMoves) {
+            const ChessUndo undo = root.makeMove(move);
+            const int score = -negamax(root, iteration - 1, -mateScore - 1, -alpha, 1);
+            root.unmakeMove(move, undo);
+
+            if(aborted) {
+                break;
+            }
+
+            if(score > alpha) {
+                alpha = score;
+                bestMove = move;
+            }
+        }
+
+        if(aborted) {
+            break;
+        }
+
+        result.bestMove = bestMove;
+        result.score = alpha;
+        result.depth = iteration;
+
+        if(std::abs(alpha) >= mateScore - maxPly) {
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    stopFlag = nullptr;
+
+    return result;
+}
+
+int ChessEngine::negamax(ChessBoard& board, int depth, int alpha, int beta, int ply) {
+    if(depth <= 0 || ply >= maxPly - 1) {
+        return quiescence(board, alpha, beta, ply);
+    }
+
+    if(shouldStop()) {
+        return 0;
+    }
+
+    ++nodes;
+
+    const uint64_t key = board.hash();
+    TableEntry& entry = table[key & (table.size() - 1)];
+    ChessMove tableMove{0, 0};
+
+    if(entry.key == key && entry.depth >= 0) {
+        tableMove = entry.move;
+
+        if(entry.depth >= depth) {
+            const int score = fromTable(entry.score, ply);
+
+            if(entry.bound == TableBoundExact
+               || (entry.bound == TableBoundLower && score >= beta)
+               || (entry.bound == TableBoundUpper && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    std::vector<ChessMove>& moves = moveLists[ply];
+    moves.clear();
+    board.generateLegalMoves(moves);
+
+    if(moves.empty()) {
+        return board.isInCheck(board.getTurn()) ? -mateScore + ply : 0;
+    }
+
+    orderMoves(board, moves, tableMove.from != tableMove.to ? &tableMove : nullptr);
+
+    const int originalAlpha = alpha;
+    int best = -mateScore - 1;
+    ChessMove bestMove = moves[0];
+
+    for(const ChessMove& move: moves) {
+        const ChessUndo undo = board.makeMove(move);
+        const int score = -negamax(board, depth - 1, -beta, -alpha, ply + 1);
+        board.unmakeMove(move, undo);
+
+        if(score > best) {
+            best = score;
+            bestMove = move;
+        }
+
+        if(score > alpha) {
+            alpha = score;
+        }
+
+        if(alpha >= beta) {
+            break;
+        }
+    }
+
+    /* Scores of an interrupted search are meaningless and mustn't reach the table. */
+    if(aborted) {
+        return 0;
+    }
+
+    const TableBound bound = best <= originalAlpha ? TableBoundUpper : best >= beta ? TableBoundLower : TableBoundExact;
+    entry = TableEntry{key, bestMove, short(toTable(best, ply)), (signed char) depth, bound};
+
+    return best;
+}
+
+int ChessEngine::quiescence(ChessBoard& board, int alpha, int beta, int ply) {
+    if(shouldStop()) {
+        return 0;
+    }
+
+    ++nodes;
+
+    const int standPat = evaluate(board);
+    if(standPat >= beta || ply >= maxPly - 1) {
+        return standPat;
+    }
+
+    alpha = std::max(alpha, standPat);
+
+    std::vector<ChessMove>& moves = moveLists[ply];
+    moves.clear();
+    board.generateLegalCaptures(moves);
+    orderMoves(board, moves, nullptr);
+
+    for(const ChessMove& move: moves) {
+        const ChessUndo undo = board.makeMove(move);
+        const int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.unmakeMove(move, undo);
+
+        if(score >= beta) {
+            return score;
+        }
+
+        alpha = std::max(alpha, score);
+    }
+
+    return alpha;
+}
+
+bool ChessEngine::shouldStop() {
+    /* The flag is only read every 1024 nodes to keep the atomic load out of the hot path. */
+    if(!aborted && (nodes & 1023) == 0) {
+        aborted = (stopFlag && stopFlag->load(std::memory_order_relaxed)) || (nodeLimit && nodes >= nodeLimit);
+    }
+
+    return aborted;
+}
+
+void ChessEngine::orderMoves(const ChessBoard& board, std::vector<ChessMove>& moves, const ChessMove* first) const {
+    /* The given move first, then captures by most valuable victim and least valuable attacker. */
+    const auto priority = [&](const ChessMove& move) {
+        if(first && move.from == first->from && move.to == first->to) {
+            return 1 << 20;
+        }
+
+        const ChessSquare& victim = board[move.to / 8][move.to % 8];
+        if(victim.piece == ChessPieceNone) {
+            return 0;
+        }
+
+        return 10 * pieceValues[victim.piece] - pieceValues[board[move.from / 8][move.from % 8].piece] / 10 + 1;
+    };
+
+    std::stable_sort(moves.begin(), moves.end(), [&](const ChessMove& a, const ChessMove& b) {
+        return priority(a) > priority(b);
+    });
+}
@@ -0,0 +1,115 @@
+/******************************************************************************************************
+ * @file  ChessEngine.hpp
+ * @brief Definition of the ChessEngine class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "ChessBoard.hpp"
+
+/**
+ * @struct SearchResult
+ * @brief The outcome of a search
+ */
+struct SearchResult {
+    ChessMove bestMove;
+    bool hasMove;       ///< False when the position has no legal move
+    int score;          ///< In centipawns, from the point of view of the color whose turn it is
+    int depth;          ///< Depth of the last completed iteration
+    uint64_t nodes;
+};
+
+/**
+ * @class ChessEngine
+ * @brief Analyses positions. An engine keeps its transposition table and move buffers between calls
+ * so it is meant to be reused, but it must only be used by one thread at a time.
+ */
+class ChessEngine {
+private:
+    static constexpr int maxPly = 64;
+
+    /**
+     * @struct TableEntry
+     * @brief A transposition table entry
+     */
+    struct TableEntry {
+        uint64_t key;
+        ChessMove move;
+        short score;
+        signed char depth;
+        unsigned char bound;
+    };
+
+    std::vector<TableEntry> table;
+    std::array<std::vector<ChessMove>, maxPly> moveLists;
+    uint64_t nodes;
+    uint64_t nodeLimit;
+
+    const std::atomic<bool>* stopFlag;
+    bool aborted;
+
+    bool shouldStop();
+
+    uint64_t perft(ChessBoard& board, int depth, int ply);
+    int negamax(ChessBoard& board, int depth, int alpha, int beta, int ply);
+    int quiescence(ChessBoard& board, int alpha, int beta, int ply);
+    void orderMoves(const ChessBoard& board, std::vector<ChessMove>& moves, const ChessMove* first) const;
+
+public:
+    static constexpr int mateScore = 30000;
+    static constexpr int maxDepth = maxPly / 2;
+
+    /**
+     * @param tableSize The number of transposition table entries, rounded down to a power of two
+     */
+    explicit ChessEngine(std::size_t tableSize = std::size_t(1) << 20);
+
+    /**
+     * @brief Empties the transposition table.
+     */
+    void clear();
+
+    /**
+     * @brief Bounds the work of each call to search and perft.
+     *
+     * @param limit The number of nodes after which they stop, 0 for no limit
+     */
+    void setNodeLimit(uint64_t limit);
+
+    /**
+     * @brief Counts the leaves of the legal move tree of a position.
+     *
+     * @param board The position
+     * @param depth The depth of the tree, at most maxPly
+     * @param stop When set from another thread, the count is abandoned
+     *
+     * @return The number of leaves, throws a std::runtime_error when stopped or when the node limit is
+     * reached
+     */
+    uint64_t perft(const ChessBoard& board, int depth, const std::atomic<bool>* stop = nullptr);
+
+    /**
+     * @brief Evaluates a position statically, using material and piece placement.
+     *
+     * @param board The position
+     *
+     * @return The score in centipawns, from the point of view of the color whose turn it is
+     */
+    int evaluate(const ChessBoard& board) const;
+
+    /**
+     * @brief Searches a position with iterative deepening alpha-beta.
+     *
+     * @param board The position
+     * @param depth The depth to search to, at most maxDepth
+     * @param stop When set from another thread, the search returns the result of the last completed
+     * iteration, as it does when the node limit is reached
+     *
+     * @return The best move found and its score
+     */
+    SearchResult search(const ChessBoard& board, int depth, const std::atomic<bool>* stop = nullptr);
+};
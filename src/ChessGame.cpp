@@ -5,16 +5,21 @@
 
 #include "ChessGame.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include "bitboards.hpp"
 #include "graphics.hpp"
 
-ChessGame::ChessGame(unsigned int width, unsigned int height)
-    : window(), renderer(), font(),
-      stop(), fullscreen(), turn(),
+ChessGame::ChessGame(unsigned int width, unsigned int height, int engineDepth, bool ponder)
+    : window(), renderer(), boardRenderer(),
+      stop(), fullscreen(),
       winSize(width, height),
       whiteSquare(255, 225, 205), blackSquare(59, 32, 18),
-      selectedSquare(ChessPieceNone, ChessColorWhite) {
+      selectedSquare(ChessPieceNone, ChessColorWhite),
+      ponderer(), engineColor(ChessColorBlack), pondering(ponder && engineDepth > 0),
+      engineThinking(), engineStart() {
 
     if(SDL_Init(SDL_INIT_VIDEO) != 0) {
         throw std::runtime_error(std::string("SDL_Init failed : ") + SDL_GetError());
@@ -28,6 +33,8 @@ ChessGame::ChessGame(unsigned int width, unsigned int height)
         throw std::runtime_error(std::string("TTF_Init failed : ") + SDL_GetError());
     }
 
+    PieceImages images;
+
     constexpr int winFlags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE;
     window = SDL_CreateWindow("Chess Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, winFlags);
     if(!window) {
@@ -39,77 +46,23 @@ ChessGame::ChessGame(unsigned int width, unsigned int height)
         throw std::runtime_error(SDL_GetError());
     }
 
-    font = TTF_OpenFont("data/fonts/courbd.ttf", 20);
-    if(!font) {
-        throw std::runtime_error(SDL_GetError());
-    }
+    boardRenderer = new BoardRenderer(renderer, whiteSquare, blackSquare, &images);
 
-    textures[ChessPieceKing][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/kingW.png"));
-    textures[ChessPieceKing][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/kingB.png"));
-    textures[ChessPieceQueen][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/queenW.png"));
-    textures[ChessPieceQueen][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/queenB.png"));
-    textures[ChessPieceBishop][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/bishopW.png"));
-    textures[ChessPieceBishop][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/bishopB.png"));
-    textures[ChessPieceKnight][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/knightW.png"));
-    textures[ChessPieceKnight][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/knightB.png"));
-    textures[ChessPieceRook][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/rookW.png"));
-    textures[ChessPieceRook][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/rookB.png"));
-    textures[ChessPiecePawn][ChessColorWhite] = createTextureFromSurface(renderer, IMG_Load("data/images/pawnW.png"));
-    textures[ChessPiecePawn][ChessColorBlack] = createTextureFromSurface(renderer, IMG_Load("data/images/pawnB.png"));
-
-    RGB pixels[8][8];
-    for(int i = 0 ; i < 8 ; ++i) {
-        for(int j = 0 ; j < 8 ; ++j) {
-            pixels[i][j] = ((i + j) % 2) ? blackSquare : whiteSquare;
-        }
-    }
+    updateBoardSurface();
 
-    Uint32 Rmask, Gmask, Bmask, Amask;
-    int bpp;
-    SDL_PixelFormatEnumToMasks(SDL_PIXELFORMAT_RGB24, &bpp, &Rmask, &Gmask, &Bmask, &Amask);
-
-    chessBoard = createTextureFromSurface(renderer, SDL_CreateRGBSurfaceFrom(pixels, 8, 8, bpp, 8 * 3, Rmask, Gmask, Bmask, Amask));
-
-    const ChessPiece boardInit[8]{
-        ChessPieceRook, ChessPieceKnight, ChessPieceBishop, ChessPieceQueen,
-        ChessPieceKing, ChessPieceBishop, ChessPieceKnight, ChessPieceRook
-    };
-
-    for(int i = 0 ; i < 8 ; ++i) {
-        for(int j = 0 ; j < 8 ; ++j) {
-            switch(i) {
-                case 0:
-                    board[i][j] = ChessSquare(boardInit[j], ChessColorBlack);
-                    break;
-                case 1:
-                    board[i][j] = ChessSquare(ChessPiecePawn, ChessColorBlack);
-                    break;
-                case 6:
-                    board[i][j] = ChessSquare(ChessPiecePawn, ChessColorWhite);
-                    break;
-                case 7:
-                    board[i][j] = ChessSquare(boardInit[j], ChessColorWhite);
-                    break;
-                default:
-                    board[i][j] = ChessSquare(ChessPieceNone, ChessColorWhite);
-                    break;
-            }
+    if(engineDepth > 0) {
+        ponderer = new Ponderer(engineDepth);
+
+        if(pondering && board.getTurn() != engineColor) {
+            ponderer->start(board);
         }
     }
-
-    updateBoardSurface();
 }
 
 ChessGame::~ChessGame() {
-    for(auto& piece: textures) {
-        for(auto& texture: piece) {
-            SDL_DestroyTexture(texture);
-        }
-    }
+    delete ponderer;
+    delete boardRenderer;
 
-    SDL_DestroyTexture(chessBoard);
-
-    TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
 
@@ -122,14 +75,22 @@ void ChessGame::run() {
     while(!stop) {
         handleEvents();
 
-        SDL_RenderPresent(renderer);
         SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
         SDL_RenderClear(renderer);
 
-        drawBoard();
+        boardRenderer->drawBoard();
         drawPieces();
-        drawLettersAndNumbers();
+        boardRenderer->drawLettersAndNumbers();
         drawUI();
+
+        SDL_RenderPresent(renderer);
+
+        logTimeToFirstFrame();
+
+        /* The engine answers once the human's move is on screen. */
+        if(ponderer && outcome.empty() && board.getTurn() == engineColor) {
+            playEngineMove();
+        }
     }
 }
 
@@ -179,71 +140,35 @@ void ChessGame::handleKeyDownEvents() {
 }
 
 void ChessGame::updateBoardSurface() {
-    boardSurface.w = std::min(winSize.x, winSize.y) * 0.8f;
-    boardSurface.h = boardSurface.w;
-    boardSurface.x = (winSize.x - boardSurface.w) / 2;
-    boardSurface.y = (winSize.y - boardSurface.h) / 2;
-
-    fontSize = boardSurface.w / 32;
-    TTF_SetFontSize(font, fontSize);
-}
-
-void ChessGame::drawBoard() const {
-    SDL_RenderCopy(renderer, chessBoard, nullptr, &boardSurface);
+    boardRenderer->fitSurface(Rect(0, 0, winSize.x, winSize.y));
 }
 
 void ChessGame::drawPieces() const {
-    SDL_Rect surface = boardSurface;
-
-    surface.w /= 8;
-    surface.h /= 8;
-
-    for(int i = 0 ; i < 8 ; ++i) {
-        for(const auto& square: board[i]) {
-            if(square.piece != ChessPieceNone) {
-                SDL_RenderCopy(renderer, textures[square.piece][square.color], nullptr, &surface);
-            }
-
-            surface.x += surface.w;
-        }
-
-        surface.x = boardSurface.x;
-        surface.y += surface.h;
-    }
+    boardRenderer->drawPieces(board);
 
     if(selectedSquare.piece != ChessPieceNone) {
+        const Rect& boardSurface = boardRenderer->getSurface();
         Point mousePos;
         SDL_GetMouseState(&mousePos.x, &mousePos.y);
 
+        Rect surface;
         surface.w = boardSurface.w / 8;
         surface.h = surface.w;
         surface.x = mousePos.x - surface.w / 2;
         surface.y = mousePos.y - surface.h / 2;
 
-        SDL_RenderCopy(renderer, textures[selectedSquare.piece][selectedSquare.color], nullptr, &surface);
-    }
-}
-
-void ChessGame::drawLettersAndNumbers() const {
-    int squareSize = boardSurface.w / 8;
-    Color color(255, 255, 255);
-    Rect rect;
-    std::string letters = "ABCDEFGH";
-
-    for(int i = 0 ; i < 8 ; ++i) {
-        rect = Rect(boardSurface.x - squareSize + squareSize / 2, boardSurface.y + squareSize * i, squareSize - squareSize / 2, squareSize);
-        renderCenteredText(renderer, font, rect, color, std::to_string(8 - i));
-
-        rect = Rect(boardSurface.x + squareSize * i, boardSurface.y + squareSize * 8, squareSize, squareSize - squareSize / 2);
-        renderCenteredText(renderer, font, rect, color, letters.substr(i, 1));
+        SDL_RenderCopy(renderer, boardRenderer->getTexture(selectedSquare), nullptr, &surface);
     }
 }
 
 void ChessGame::drawUI() const {
+    const Rect& boardSurface = boardRenderer->getSurface();
+    TTF_Font* font = boardRenderer->getFont();
+    const int fontSize = boardRenderer->getFontSize();
     Color textColor;
     std::string text("It is ");
 
-    if(turn == ChessColorWhite) {
+    if(board.getTurn() == ChessColorWhite) {
         SDL_SetRenderDrawColor(renderer, whiteSquare.r, whiteSquare.g, whiteSquare.b, 255);
         textColor = blackSquare;
         text += "White's turn !";
@@ -253,6 +178,10 @@ void ChessGame::drawUI() const {
         text += "Black's turn !";
     }
 
+    if(!outcome.empty()) {
+        text = outcome;
+    }
+
     Rect rect(boardSurface.x, boardSurface.y * 0.2f, boardSurface.w, boardSurface.y * 0.6f);
     SDL_RenderFillRect(renderer, &rect);
 
@@ -262,9 +191,14 @@ void ChessGame::drawUI() const {
 }
 
 void ChessGame::movePiece() {
+    const Rect& boardSurface = boardRenderer->getSurface();
     Point mousePos, indexes;
     SDL_GetMouseState(&mousePos.x, &mousePos.y);
 
+    if(!outcome.empty() || (ponderer && board.getTurn() == engineColor)) {
+        return;
+    }
+
     if(event.button.state == SDL_PRESSED && event.button.button == SDL_BUTTON_LEFT) {
         indexes.x = (mousePos.y - boardSurface.y) / (boardSurface.w / 8);
         indexes.y = (mousePos.x - boardSurface.x) / (boardSurface.w / 8);
@@ -274,7 +208,7 @@ void ChessGame::movePiece() {
         }
 
         if(selectedSquare.piece == ChessPieceNone) {
-            if(board[indexes.x][indexes.y].color != turn) {
+            if(board[indexes.x][indexes.y].color != board.getTurn()) {
                 return;
             }
 
@@ -284,7 +218,7 @@ void ChessGame::movePiece() {
             board[indexes.x][indexes.y].piece = ChessPieceNone;
             board[indexes.x][indexes.y].color = ChessColorWhite;
         } else {
-            if(board[indexes.x][indexes.y].color == turn && board[indexes.x][indexes.y].piece != ChessPieceNone) {
+            if(board[indexes.x][indexes.y].color == board.getTurn() && board[indexes.x][indexes.y].piece != ChessPieceNone) {
                 return;
             } else if(!testMoves(indexes)) {
                 board[selectedIndex.x][selectedIndex.y] = selectedSquare;
@@ -298,166 +232,96 @@ void ChessGame::movePiece() {
             selectedSquare.color = ChessColorWhite;
 
             if(indexes.x != selectedIndex.x || indexes.y != selectedIndex.y) {
-                turn = turn ? ChessColorWhite : ChessColorBlack;
-            }
-        }
-    }
-}
+                board.nextTurn();
 
-bool ChessGame::testMoves(const Point& target) {
-    switch(selectedSquare.piece) {
-        case ChessPieceKing:
-            return movesKing(target);
-        case ChessPieceQueen:
-            return movesQueen(target);
-        case ChessPieceBishop:
-            return movesBishop(target);
-        case ChessPieceKnight:
-            return movesKnight(target);
-        case ChessPieceRook:
-            return movesRook(target);
-        case ChessPiecePawn:
-            if(movesPawn(target)) {
-                if((selectedSquare.color == ChessColorWhite && target.x == 0) || (selectedSquare.color == ChessColorBlack && target.x == 7)) {
-                    selectedSquare.piece = ChessPieceQueen;
+                if(ponderer) {
+                    checkGameOver();
                 }
-                return true;
             }
-            return false;
-        default:
-            return false;
-    }
-}
-
-bool ChessGame::movesKing(const Point& target) {
-    Point moves[]{Point(-1, -1),
-                  Point(-1, 0),
-                  Point(-1, 1),
-                  Point(0, -1),
-                  Point(1, -1),
-                  Point(1, 0),
-                  Point(1, 1),
-                  Point(0, 1)};
-
-    for(const Point& move: moves) {
-        if((selectedIndex.x + move.x) == target.x && (selectedIndex.y + move.y) == target.y) {
-            return true;
         }
     }
-
-    return false;
 }
 
-bool ChessGame::movesQueen(const Point& target) {
-    return movesBishop(target) || movesRook(target);
-}
+void ChessGame::playEngineMove() {
+    /* The search runs on the ponderer's thread, the window keeps handling events meanwhile. */
+    if(!engineThinking) {
+        engineStart = SDL_GetPerformanceCounter();
+        engineThinking = true;
+        ponderer->play(board);
+    }
 
-bool ChessGame::movesBishop(const Point& target) {
-    unsigned int factor;
-    Point index;
-    Point moves[]{Point(-1, -1),
-                  Point(-1, 1),
-                  Point(1, -1),
-                  Point(1, 1)};
+    SearchResult result;
+    bool cached;
+    if(!ponderer->poll(result, cached)) {
+        return;
+    }
 
-    for(const Point& move: moves) {
-        factor = 1;
+    const double latency = 1000.0 * (SDL_GetPerformanceCounter() - engineStart) / SDL_GetPerformanceFrequency();
+    engineThinking = false;
 
-        index.x = selectedIndex.x + move.x * factor;
-        index.y = selectedIndex.y + move.y * factor;
+    if(!result.hasMove) {
+        checkGameOver();
+        return;
+    }
 
-        do {
-            index.x = selectedIndex.x + move.x * factor;
-            index.y = selectedIndex.y + move.y * factor;
+    board.makeMove(result.bestMove);
 
-            if(index.x == target.x && index.y == target.y) {
-                return true;
-            }
+    SDL_Log("The engine played %s in %.2f ms (%s, depth %d, score %d)", result.bestMove.toString().c_str(), latency,
+            cached ? "pondered" : "searched", result.depth, result.score);
 
-            ++factor;
-        } while(index.x >= 0 && index.x < 8 && index.y >= 0 && index.y < 8 && board[index.x][index.y].piece == ChessPieceNone);
+    checkGameOver();
 
-        if(index.x == target.x && index.y == target.y) {
-            return true;
-        }
+    if(pondering && outcome.empty()) {
+        ponderer->start(board);
     }
-
-    return false;
 }
 
-bool ChessGame::movesKnight(const Point& target) {
-    Point moves[8]{Point(-2, -1),
-                   Point(-2, 1),
-                   Point(-1, -2),
-                   Point(-1, 2),
-                   Point(1, -2),
-                   Point(1, 2),
-                   Point(2, -1),
-                   Point(2, 1)};
-
-    for(const Point& move: moves) {
-        if((selectedIndex.x + move.x) == target.x && (selectedIndex.y + move.y) == target.y) {
-            return true;
-        }
+void ChessGame::checkGameOver() {
+    std::vector<ChessMove> moves;
+    board.generateLegalMoves(moves);
+
+    if(!moves.empty()) {
+        return;
     }
 
-    return false;
-}
+    if(!board.isInCheck(board.getTurn())) {
+        outcome = "Stalemate !";
+    } else if(board.getTurn() == ChessColorWhite) {
+        outcome = "Checkmate, Black wins !";
+    } else {
+        outcome = "Checkmate, White wins !";
+    }
 
-bool ChessGame::movesRook(const Point& target) {
-    unsigned int factor;
-    Point index;
-    Point moves[]{Point(-1, 0),
-                  Point(1, 0),
-                  Point(0, -1),
-                  Point(0, 1)};
+    /* Nothing is left to think about, the background search would only keep a core busy. */
+    ponderer->stop();
 
-    for(const Point& move: moves) {
-        factor = 1;
+    SDL_Log("%s", outcome.c_str());
+}
 
-        do {
-            index.x = selectedIndex.x + move.x * factor;
-            index.y = selectedIndex.y + move.y * factor;
+bool ChessGame::testMoves(const Point& target) {
+    if(!board.testMoves(selectedSquare, selectedIndex, target)) {
+        return false;
+    }
 
-            if(index.x == target.x && index.y == target.y) {
-                return true;
-            }
+    /* The engine only knows legal chess, so against it the king can't be left in check. */
+    if(ponderer) {
+        ChessBoard position = board;
+        position[selectedIndex.x][selectedIndex.y] = selectedSquare;
 
-            ++factor;
-        } while(index.x >= 0 && index.x < 8 && index.y >= 0 && index.y < 8 && board[index.x][index.y].piece == ChessPieceNone);
+        std::vector<ChessMove> moves;
+        position.generateLegalMoves(moves);
 
-        if(index.x == target.x && index.y == target.y) {
-            return true;
+        const ChessMove move{(unsigned char) square(selectedIndex.x, selectedIndex.y), (unsigned char) square(target.x, target.y)};
+        if(std::none_of(moves.begin(), moves.end(), [&](const ChessMove& legal) { return legal.from == move.from && legal.to == move.to; })) {
+            return false;
         }
     }
 
-    return false;
-}
-
-bool ChessGame::movesPawn(const Point& target) {
-    Point index;
-    Point moves[](Point(turn ? 1 : -1, 0),
-                  Point(turn ? 1 : -1, -1),
-                  Point(turn ? 1 : -1, 1),
-                  Point(turn ? 2 : -2, 0));
-
-
-    for(int i = 0 ; i < 4 ; ++i) {
-        index.x = selectedIndex.x + moves[i].x;
-        index.y = selectedIndex.y + moves[i].y;
-
-        if(index.x == target.x && index.y == target.y) {
-            switch(i) {
-                case 0:
-                    return board[index.x][index.y].piece == ChessPieceNone;
-                case 1:
-                case 2:
-                    return board[index.x][index.y].piece != ChessPieceNone;
-                case 3:
-                    return (turn == ChessColorWhite && selectedIndex.x == 6) || (turn == ChessColorBlack && selectedIndex.x == 1);
-            }
+    if(selectedSquare.piece == ChessPiecePawn) {
+        if((selectedSquare.color == ChessColorWhite && target.x == 0) || (selectedSquare.color == ChessColorBlack && target.x == 7)) {
+            selectedSquare.piece = ChessPieceQueen;
         }
     }
 
-    return false;
+    return true;
 }
\ No newline at end of file
@@ -9,45 +9,15 @@
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <string>
 #include <unordered_map>
+#include "BoardRenderer.hpp"
+#include "ChessBoard.hpp"
 #include "Color.hpp"
+#include "Ponderer.hpp"
 #include "Rect.hpp"
 #include "Point.hpp"
 
-/**
- * @enum ChessPiece
- * @brief Represents the different pieces of a chess game
- */
-enum ChessPiece : char {
-    ChessPieceKing,
-    ChessPieceQueen,
-    ChessPieceBishop,
-    ChessPieceKnight,
-    ChessPieceRook,
-    ChessPiecePawn,
-    ChessPieceNone
-};
-
-/**
- * @enum ChessColor
- * @brief Represents the different colors for the pieces of a chess game
- */
-enum ChessColor : char {
-    ChessColorWhite,
-    ChessColorBlack,
-};
-
-/**
- * @struct ChessSquare
- * @brief Represents a square of the chess board
- */
-struct ChessSquare {
-    ChessSquare() = default;
-    ChessSquare(ChessPiece piece, ChessColor color) : piece(piece), color(color) { }
-    ChessPiece piece;
-    ChessColor color;
-};
-
 /**
  * @class ChessGame
  * @brief
@@ -56,47 +26,49 @@ class ChessGame {
 private:
     SDL_Window* window;
     SDL_Renderer* renderer;
+    BoardRenderer* boardRenderer;
 
-    TTF_Font* font;
-    int fontSize;
-
-    bool stop, fullscreen, turn;
+    bool stop, fullscreen;
     SDL_Event event;
     std::unordered_map<SDL_Scancode, bool> flags;
 
     Point winSize;
-    Rect boardSurface;
     const RGB whiteSquare, blackSquare;
 
-    SDL_Texture* textures[6][2];
-    SDL_Texture* chessBoard;
-
-    ChessSquare board[8][8];
+    ChessBoard board;
 
     ChessSquare selectedSquare;
     Point selectedIndex;
 
+    Ponderer* ponderer;     ///< Nullptr when both sides are played by humans
+    const ChessColor engineColor;
+    const bool pondering;
+    bool engineThinking;
+    Uint64 engineStart;     ///< Performance counter when the engine was asked for its move
+
+    std::string outcome;    ///< Shown instead of whose turn it is once the game is over
+
     void handleEvents();
     void handleKeyDownEvents();
     void updateBoardSurface();
 
-    void drawBoard() const;
     void drawPieces() const;
-    void drawLettersAndNumbers() const;
     void drawUI() const;
 
     void movePiece();
-    
+    void playEngineMove();
+    void checkGameOver();
+
     bool testMoves(const Point& target);
-    bool movesKing(const Point& target);
-    bool movesQueen(const Point& target);
-    bool movesBishop(const Point& target);
-    bool movesKnight(const Point& target);
-    bool movesRook(const Point& target);
-    bool movesPawn(const Point& target);
 
 public:
-    ChessGame(unsigned int width, unsigned int height);
+    /**
+     * @param width The width of the window
+     * @param height The height of the window
+     * @param engineDepth When positive, the engine plays Black and searches to this depth
+     * @param ponder Whether the engine thinks during White's turn
+     */
+    ChessGame(unsigned int width, unsigned int height, int engineDepth = 0, bool ponder = false);
     ~ChessGame();
 
     void run();
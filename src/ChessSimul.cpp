@@ -0,0 +1,303 @@
+/******************************************************************************************************
+ * @file  ChessSimul.cpp
+ * @brief Implementation of the ChessSimul class
+ ******************************************************************************************************/
+
+#include "ChessSimul.hpp"
+
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "bitboards.hpp"
+#include "graphics.hpp"
+
+ChessSimul::ChessSimul(unsigned int width, unsigned int height, unsigned int gameCount)
+    : window(), renderer(), boardRenderer(), canvas(),
+      stop(), fullscreen(), selfPlay(),
+      winSize(width, height),
+      whiteSquare(255, 225, 205), blackSquare(59, 32, 18),
+      games(std::max(gameCount, 1u), SimulGame{ChessBoard(), -1, true}),
+      random(std::random_device()()) {
+
+    if(SDL_Init(SDL_INIT_VIDEO) != 0) {
+        throw std::runtime_error(std::string("SDL_Init failed : ") + SDL_GetError());
+    }
+
+    if(IMG_Init(IMG_INIT_PNG) <= 0) {
+        throw std::runtime_error(std::string("IMG_Init failed : ") + SDL_GetError());
+    }
+
+    if(TTF_Init() != 0) {
+        throw std::runtime_error(std::string("TTF_Init failed : ") + SDL_GetError());
+    }
+
+    PieceImages images;
+
+    constexpr int winFlags = SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE;
+    window = SDL_CreateWindow("Chess Simul", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, winFlags);
+    if(!window) {
+        throw std::runtime_error(SDL_GetError());
+    }
+
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
+    if(!renderer) {
+        throw std::runtime_error(SDL_GetError());
+    }
+
+    boardRenderer = new BoardRenderer(renderer, whiteSquare, blackSquare, &images);
+
+    updateLayout();
+}
+
+ChessSimul::~ChessSimul() {
+    SDL_DestroyTexture(canvas);
+    delete boardRenderer;
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+}
+
+void ChessSimul::run() {
+    Uint64 fpsStart = SDL_GetPerformanceCounter();
+    unsigned int frames = 0;
+
+    while(!stop) {
+        handleEvents();
+
+        if(selfPlay) {
+            playRandomMove();
+        }
+
+        SDL_SetRenderTarget(renderer, canvas);
+        for(std::size_t i = 0 ; i < games.size() ; ++i) {
+            if(games[i].dirty) {
+                drawGame(i);
+            }
+        }
+        SDL_SetRenderTarget(renderer, nullptr);
+
+        SDL_RenderCopy(renderer, canvas, nullptr, nullptr);
+        SDL_RenderPresent(renderer);
+
+        logTimeToFirstFrame();
+
+        ++frames;
+        const double elapsed = double(SDL_GetPerformanceCounter() - fpsStart) / SDL_GetPerformanceFrequency();
+        if(elapsed >= 1.0) {
+            const std::string title = "Chess Simul - " + std::to_string(games.size()) + " games - "
+                                      + std::to_string(int(frames / elapsed)) + " fps";
+            SDL_SetWindowTitle(window, title.c_str());
+
+            fpsStart = SDL_GetPerformanceCounter();
+            frames = 0;
+        }
+    }
+}
+
+void ChessSimul::handleEvents() {
+    while(SDL_PollEvent(&event)) {
+        switch(event.type) {
+            case SDL_QUIT:
+                stop = true;
+                break;
+            case SDL_KEYDOWN:
+                handleKeyDownEvents();
+                break;
+            case SDL_WINDOWEVENT:
+                if(event.window.event == SDL_WINDOWEVENT_RESIZED) {
+                    SDL_GetWindowSize(window, &winSize.x, &winSize.y);
+                    updateLayout();
+                }
+                break;
+            case SDL_MOUSEBUTTONDOWN:
+                selectSquare();
+                break;
+            case SDL_RENDER_TARGETS_RESET:
+                updateLayout();
+                break;
+            case SDL_RENDER_DEVICE_RESET:
+                /* Every texture is lost, the shared ones have to be created again. */
+                delete boardRenderer;
+                boardRenderer = new BoardRenderer(renderer, whiteSquare, blackSquare);
+                updateLayout();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void ChessSimul::handleKeyDownEvents() {
+    /* Holding a key mustn't toggle fullscreen or self-play over and over. */
+    if(event.key.repeat) {
+        return;
+    }
+
+    switch(event.key.keysym.scancode) {
+        case SDL_SCANCODE_ESCAPE:
+            stop = true;
+            break;
+        case SDL_SCANCODE_F11:
+            SDL_SetWindowFullscreen(window, fullscreen ? 0 : SDL_WINDOW_FULLSCREEN);
+            fullscreen = !fullscreen;
+            break;
+        case SDL_SCANCODE_SPACE:
+            selfPlay = !selfPlay;
+            break;
+        case SDL_SCANCODE_R:
+            for(SimulGame& game: games) {
+                game.board.setStartingPosition();
+                game.selected = -1;
+                game.dirty = true;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void ChessSimul::updateLayout() {
+    /* As many columns as needed for the tiles to be about square. */
+    const double ratio = double(winSize.x) / std::max(winSize.y, 1);
+    grid.x = std::clamp(int(std::ceil(std::sqrt(games.size() * ratio))), 1, int(games.size()));
+    grid.y = (int(games.size()) + grid.x - 1) / grid.x;
+    /* With more games than pixels the tiles overflow the window, but they are never empty. */
+    tileSize = Point(std::max(winSize.x / grid.x, 1), std::max(winSize.y / grid.y, 1));
+
+    SDL_DestroyTexture(canvas);
+    canvas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, std::max(winSize.x, 1), std::max(winSize.y, 1));
+    if(!canvas) {
+        throw std::runtime_error(std::string("SDL_CreateTexture failed : ") + SDL_GetError());
+    }
+
+    SDL_SetRenderTarget(renderer, canvas);
+    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderTarget(renderer, nullptr);
+
+    for(SimulGame& game: games) {
+        game.dirty = true;
+    }
+}
+
+void ChessSimul::drawGame(std::size_t index) {
+    SimulGame& game = games[index];
+    const Rect tile((index % grid.x) * tileSize.x, (index / grid.x) * tileSize.y, tileSize.x, tileSize.y);
+
+    SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
+    SDL_RenderFillRect(renderer, &tile);
+
+    boardRenderer->fitSurface(tile);
+    const Rect& boardSurface = boardRenderer->getSurface();
+
+    boardRenderer->drawBoard();
+    boardRenderer->drawPieces(game.board);
+
+    if(game.selected >= 0) {
+        const int squareSize = boardSurface.w / 8;
+        Rect rect(boardSurface.x + squareSize * (game.selected % 8), boardSurface.y + squareSize * (game.selected / 8), squareSize, squareSize);
+
+        SDL_SetRenderDrawColor(renderer, 255, 200, 0, 255);
+        SDL_RenderDrawRect(renderer, &rect);
+        rect = Rect(rect.x + 1, rect.y + 1, rect.w - 2, rect.h - 2);
+        SDL_RenderDrawRect(renderer, &rect);
+    }
+
+    /* Below this size the letters and numbers can't be read anyway. */
+    if(boardRenderer->getFontSize() >= 8) {
+        boardRenderer->drawLettersAndNumbers();
+    }
+
+    /* A bar above the board shows whose turn it is, like the banner of ChessGame. */
+    const RGB& turnColor = game.board.getTurn() == ChessColorWhite ? whiteSquare : blackSquare;
+    const int margin = boardSurface.y - tile.y;
+    const Rect bar(boardSurface.x, tile.y + margin / 4, boardSurface.w, margin / 2);
+
+    SDL_SetRenderDrawColor(renderer, turnColor.r, turnColor.g, turnColor.b, 255);
+    SDL_RenderFillRect(renderer, &bar);
+
+    game.dirty = false;
+}
+
+void ChessSimul::selectSquare() {
+    const Point mousePos(event.button.x, event.button.y);
+    const Point tileIndex(mousePos.x / tileSize.x, mousePos.y / tileSize.y);
+    const std::size_t index = tileIndex.y * grid.x + tileIndex.x;
+
+    if(tileIndex.x >= grid.x || tileIndex.y >= grid.y || index >= games.size()) {
+        return;
+    }
+
+    SimulGame& game = games[index];
+
+    if(event.button.button != SDL_BUTTON_LEFT) {
+        game.selected = -1;
+        game.dirty = true;
+        return;
+    }
+
+    boardRenderer->fitSurface(Rect(tileIndex.x * tileSize.x, tileIndex.y * tileSize.y, tileSize.x, tileSize.y));
+    const Rect& boardSurface = boardRenderer->getSurface();
+    const int squareSize = boardSurface.w / 8;
+
+    /* A board smaller than a pixel per square can't be played on. */
+    if(squareSize == 0 || mousePos.x < boardSurface.x || mousePos.y < boardSurface.y) {
+        return;
+    }
+
+    const Point target((mousePos.y - boardSurface.y) / squareSize, (mousePos.x - boardSurface.x) / squareSize);
+    if(target.x >= 8 || target.y >= 8) {
+        return;
+    }
+
+    const ChessSquare& targetSquare = game.board[target.x][target.y];
+
+    if(targetSquare.piece != ChessPieceNone && targetSquare.color == game.board.getTurn()) {
+        game.selected = square(target.x, target.y);
+    } else if(game.selected >= 0) {
+        /* Checked against the legal moves, like self-play, so a king can't be left to be captured. */
+        const ChessMove move{(unsigned char) game.selected, (unsigned char) square(target.x, target.y)};
+
+        moves.clear();
+        game.board.generateLegalMoves(moves);
+
+        if(std::any_of(moves.begin(), moves.end(), [&](const ChessMove& legal) { return legal.from == move.from && legal.to == move.to; })) {
+            game.board.makeMove(move);
+        }
+
+        game.selected = -1;
+    } else {
+        return;
+    }
+
+    game.dirty = true;
+}
+
+void ChessSimul::playRandomMove() {
+    /* About one move per game and per second at 60 fps. */
+    const std::size_t count = std::max<std::size_t>(games.size() / 60, 1);
+
+    for(std::size_t i = 0 ; i < count ; ++i) {
+        SimulGame& game = games[random() % games.size()];
+
+        moves.clear();
+        game.board.generateLegalMoves(moves);
+
+        if(moves.empty()) {
+            game.board.setStartingPosition();
+        } else {
+            game.board.makeMove(moves[random() % moves.size()]);
+        }
+
+        game.selected = -1;
+        game.dirty = true;
+    }
+}
@@ -0,0 +1,66 @@
+/******************************************************************************************************
+ * @file  ChessSimul.hpp
+ * @brief Definition of the ChessSimul class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <random>
+#include <vector>
+#include "BoardRenderer.hpp"
+#include "ChessBoard.hpp"
+#include "Color.hpp"
+#include "Rect.hpp"
+#include "Point.hpp"
+
+/**
+ * @struct SimulGame
+ * @brief The state of one of the games of a simul
+ */
+struct SimulGame {
+    ChessBoard board;
+    signed char selected;   ///< Square of the selected piece, -1 when there is none
+    bool dirty;             ///< Whether the game changed since its tile was last drawn
+};
+
+/**
+ * @class ChessSimul
+ * @brief Shows many independent games tiled in a single window, sharing one renderer, one set of
+ * textures and one font. Tiles are drawn to a canvas texture and only the games that changed are
+ * drawn again each frame.
+ */
+class ChessSimul {
+private:
+    SDL_Window* window;
+    SDL_Renderer* renderer;
+    BoardRenderer* boardRenderer;
+    SDL_Texture* canvas;
+
+    bool stop, fullscreen, selfPlay;
+    SDL_Event event;
+
+    Point winSize;
+    Point grid;
+    Point tileSize;
+    const RGB whiteSquare, blackSquare;
+
+    std::vector<SimulGame> games;
+    std::vector<ChessMove> moves;
+    std::mt19937 random;
+
+    void handleEvents();
+    void handleKeyDownEvents();
+    void updateLayout();
+
+    void drawGame(std::size_t index);
+    void selectSquare();
+    void playRandomMove();
+
+public:
+    ChessSimul(unsigned int width, unsigned int height, unsigned int gameCount);
+    ~ChessSimul();
+
+    void run();
+};
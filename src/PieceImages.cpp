@@ -0,0 +1,66 @@
+/******************************************************************************************************
+ * @file  PieceImages.cpp
+ * @brief Implementation of the PieceImages class
+ ******************************************************************************************************/
+
+#include "PieceImages.hpp"
+
+#include <SDL2/SDL_image.h>
+#include <stdexcept>
+#include <string>
+#include "assets.hpp"
+
+/* Indexed by ChessPiece then ChessColor. */
+static const char* const imageNames[6][2]{
+    {"images/kingW.png", "images/kingB.png"},
+    {"images/queenW.png", "images/queenB.png"},
+    {"images/bishopW.png", "images/bishopB.png"},
+    {"images/knightW.png", "images/knightB.png"},
+    {"images/rookW.png", "images/rookB.png"},
+    {"images/pawnW.png", "images/pawnB.png"}
+};
+
+static SDL_Surface* decodeImage(const char* name) {
+    SDL_Surface* surface = IMG_Load_RW(openAsset(name), 1);
+
+    /* SDL's errors are per thread, the message has to be read here. */
+    if(!surface) {
+        throw std::runtime_error(std::string("IMG_Load_RW failed for ") + name + " : " + SDL_GetError());
+    }
+
+    return surface;
+}
+
+PieceImages::PieceImages()
+    : surfaces() {
+
+    for(int piece = 0 ; piece < 6 ; ++piece) {
+        for(int color = 0 ; color < 2 ; ++color) {
+            decoding[piece][color] = std::async(std::launch::async, decodeImage, imageNames[piece][color]);
+        }
+    }
+}
+
+PieceImages::~PieceImages() {
+    for(int piece = 0 ; piece < 6 ; ++piece) {
+        for(int color = 0 ; color < 2 ; ++color) {
+            if(decoding[piece][color].valid()) {
+                try {
+                    surfaces[piece][color] = decoding[piece][color].get();
+                } catch(const std::exception&) {
+                    /* Nothing to free. */
+                }
+            }
+
+            SDL_FreeSurface(surfaces[piece][color]);
+        }
+    }
+}
+
+SDL_Surface* PieceImages::getSurface(ChessPiece piece, ChessColor color) {
+    if(decoding[piece][color].valid()) {
+        surfaces[piece][color] = decoding[piece][color].get();
+    }
+
+    return surfaces[piece][color];
+}
@@ -0,0 +1,44 @@
+/******************************************************************************************************
+ * @file  PieceImages.hpp
+ * @brief Definition of the PieceImages class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <future>
+#include "ChessBoard.hpp"
+
+/**
+ * @class PieceImages
+ * @brief Decodes the embedded images of the pieces, each on its own thread, so decoding can overlap
+ * with other work such as creating the window. Only surfaces are created here, turning them into
+ * textures is left to the thread owning the renderer.
+ */
+class PieceImages {
+private:
+    std::future<SDL_Surface*> decoding[6][2];
+    SDL_Surface* surfaces[6][2];
+
+public:
+    /**
+     * @brief Starts decoding every image and returns immediately. IMG_Init must have been called.
+     */
+    PieceImages();
+    ~PieceImages();
+
+    PieceImages(const PieceImages&) = delete;
+    PieceImages& operator=(const PieceImages&) = delete;
+
+    /**
+     * @brief Waits for the image of a piece to be decoded.
+     *
+     * @param piece The piece, can't be ChessPieceNone
+     * @param color The color of the piece
+     *
+     * @return The image, which stays owned by this object. Throws a std::runtime_error when it couldn't
+     * be decoded.
+     */
+    SDL_Surface* getSurface(ChessPiece piece, ChessColor color);
+};
@@ -0,0 +1,153 @@
+/******************************************************************************************************
+ * @file  Ponderer.cpp
+ * @brief Implementation of the Ponderer class
+ ******************************************************************************************************/
+
+#include "Ponderer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+Ponderer::Ponderer(int depth)
+    : depth(std::clamp(depth, 1, ChessEngine::maxDepth)),
+      task(TaskNone), busy(), quit(), stopSearch(),
+      move{{0, 0}, false, 0, 0, 0}, moveReady(), moveCached() {
+
+    thread = std::thread(&Ponderer::work, this);
+}
+
+Ponderer::~Ponderer() {
+    {
+        std::lock_guard lock(mutex);
+        quit = true;
+        stopSearch = true;
+    }
+
+    wakeUp.notify_one();
+    thread.join();
+}
+
+void Ponderer::start(const ChessBoard& board) {
+    stop();
+
+    {
+        std::lock_guard lock(mutex);
+        position = board;
+        task = TaskPonder;
+
+        /* Entries of earlier moves can't be reached anymore. */
+        cache.clear();
+    }
+
+    wakeUp.notify_one();
+}
+
+void Ponderer::stop() {
+    std::unique_lock lock(mutex);
+
+    task = TaskNone;
+    moveReady = false;
+    stopSearch = true;
+    idle.wait(lock, [this] { return !busy; });
+}
+
+void Ponderer::play(const ChessBoard& board) {
+    stop();
+
+    {
+        std::lock_guard lock(mutex);
+
+        /* Only searches that weren't interrupted are cached. */
+        const auto it = cache.find(board.hash());
+        if(it != cache.end()) {
+            move = it->second;
+            moveCached = true;
+            moveReady = true;
+            return;
+        }
+
+        position = board;
+        task = TaskPlay;
+        moveCached = false;
+    }
+
+    wakeUp.notify_one();
+}
+
+bool Ponderer::poll(SearchResult& result, bool& cached) {
+    std::lock_guard lock(mutex);
+
+    if(!moveReady) {
+        return false;
+    }
+
+    result = move;
+    cached = moveCached;
+    moveReady = false;
+
+    return true;
+}
+
+void Ponderer::work() {
+    std::unique_lock lock(mutex);
+
+    while(true) {
+        wakeUp.wait(lock, [this] { return quit || task != TaskNone; });
+
+        if(quit) {
+            return;
+        }
+
+        const Task current = task;
+        const ChessBoard root = position;
+        task = TaskNone;
+        busy = true;
+        stopSearch = false;
+
+        lock.unlock();
+
+        if(current == TaskPonder) {
+            ponder(root);
+            lock.lock();
+        } else {
+            const SearchResult result = engine.search(root, depth, &stopSearch);
+            lock.lock();
+
+            if(!stopSearch) {
+                move = result;
+                moveReady = true;
+            }
+        }
+
+        busy = false;
+        idle.notify_all();
+    }
+}
+
+void Ponderer::ponder(const ChessBoard& root) {
+    /* A shallower search of the current position is enough to guess the opponent's reply. */
+    const SearchResult prediction = engine.search(root, std::max(depth - 1, 1), &stopSearch);
+    if(stopSearch || !prediction.hasMove) {
+        return;
+    }
+
+    std::vector<ChessMove> replies;
+    root.generateLegalMoves(replies);
+
+    std::stable_partition(replies.begin(), replies.end(), [&](const ChessMove& reply) {
+        return reply.from == prediction.bestMove.from && reply.to == prediction.bestMove.to;
+    });
+
+    for(const ChessMove& reply: replies) {
+        ChessBoard next = root;
+        next.makeMove(reply);
+
+        const SearchResult result = engine.search(next, depth, &stopSearch);
+        if(stopSearch) {
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        cache[next.hash()] = result;
+    }
+}
@@ -0,0 +1,97 @@
+/******************************************************************************************************
+ * @file  Ponderer.hpp
+ * @brief Definition of the Ponderer class
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "ChessBoard.hpp"
+#include "ChessEngine.hpp"
+
+/**
+ * @class Ponderer
+ * @brief Plays the engine's moves and thinks on the opponent's time, on a background thread so the
+ * caller never waits for a search. While the opponent is to move, the thread predicts their reply by
+ * searching the current position, then searches the position after the predicted reply and after
+ * every other reply. The results are cached by position so the engine can answer instantly when the
+ * opponent plays one of them.
+ */
+class Ponderer {
+private:
+    /**
+     * @enum Task
+     * @brief What the thread was asked to do with the position
+     */
+    enum Task : char {
+        TaskNone,
+        TaskPonder,
+        TaskPlay
+    };
+
+    ChessEngine engine;
+    const int depth;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeUp, idle;
+
+    ChessBoard position;
+    Task task;
+    bool busy, quit;
+    std::atomic<bool> stopSearch;
+
+    std::unordered_map<uint64_t, SearchResult> cache;
+
+    SearchResult move;
+    bool moveReady, moveCached;
+
+    void work();
+    void ponder(const ChessBoard& root);
+
+public:
+    /**
+     * @param depth The depth the engine searches its moves to
+     */
+    explicit Ponderer(int depth);
+    ~Ponderer();
+
+    Ponderer(const Ponderer&) = delete;
+    Ponderer& operator=(const Ponderer&) = delete;
+
+    /**
+     * @brief Starts thinking in the background, replacing whatever was being analysed.
+     *
+     * @param board The position, with the opponent to move
+     */
+    void start(const ChessBoard& board);
+
+    /**
+     * @brief Interrupts the background work, including a move being searched, and waits until the
+     * thread is idle.
+     */
+    void stop();
+
+    /**
+     * @brief Asks for the engine's move, which is taken from the cache when the position was pondered
+     * and searched in the background otherwise. Pondering is stopped first.
+     *
+     * @param board The position, with the engine to move
+     */
+    void play(const ChessBoard& board);
+
+    /**
+     * @brief Checks whether the move asked for with play is ready, without waiting.
+     *
+     * @param result Set to the result of the search once it is ready
+     * @param cached Set to whether the result came from the cache
+     *
+     * @return Whether the move is ready, it is only returned once
+     */
+    bool poll(SearchResult& result, bool& cached);
+};
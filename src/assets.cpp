@@ -0,0 +1,29 @@
+/******************************************************************************************************
+ * @file  assets.cpp
+ * @brief Implementation of the access to the embedded assets
+ ******************************************************************************************************/
+
+#include "assets.hpp"
+
+#include <stdexcept>
+
+const EmbeddedAsset& findAsset(const std::string& name) {
+    for(std::size_t i = 0 ; i < embeddedAssetCount ; ++i) {
+        if(name == embeddedAssets[i].name) {
+            return embeddedAssets[i];
+        }
+    }
+
+    throw std::runtime_error("No embedded asset named " + name);
+}
+
+SDL_RWops* openAsset(const std::string& name) {
+    const EmbeddedAsset& asset = findAsset(name);
+
+    SDL_RWops* stream = SDL_RWFromConstMem(asset.data, int(asset.size));
+    if(!stream) {
+        throw std::runtime_error(std::string("SDL_RWFromConstMem failed : ") + SDL_GetError());
+    }
+
+    return stream;
+}
@@ -0,0 +1,42 @@
+/******************************************************************************************************
+ * @file  assets.hpp
+ * @brief Access to the files of data/ embedded in the executable at build time
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @struct EmbeddedAsset
+ * @brief A file embedded by cmake/EmbedAssets.cmake
+ */
+struct EmbeddedAsset {
+    const char* name;       ///< Path relative to data/, e.g. "images/kingW.png"
+    const unsigned char* data;
+    std::size_t size;
+};
+
+/* Defined in the source generated by the build. */
+extern const EmbeddedAsset embeddedAssets[];
+extern const std::size_t embeddedAssetCount;
+
+/**
+ * @brief Finds an embedded asset.
+ *
+ * @param name The path of the asset relative to data/
+ *
+ * @return The asset, throws a std::runtime_error when there is none with this name
+ */
+const EmbeddedAsset& findAsset(const std::string& name);
+
+/**
+ * @brief Opens an embedded asset for SDL functions taking a SDL_RWops.
+ *
+ * @param name The path of the asset relative to data/
+ *
+ * @return A read-only stream over the asset, to be closed by the caller or by the function it is given to
+ */
+SDL_RWops* openAsset(const std::string& name);
@@ -0,0 +1,355 @@
+/******************************************************************************************************
+ * @file  bench.cpp
+ * @brief Microbenchmarks of the move validation, board setup and text rendering, with a regression
+ * check against a stored baseline
+ ******************************************************************************************************/
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ChessBoard.hpp"
+#include "assets.hpp"
+#include "graphics.hpp"
+
+/**
+ * @struct BenchmarkResult
+ * @brief The timing of one benchmark
+ */
+struct BenchmarkResult {
+    std::string name;
+    std::size_t iterations;
+    double nsPerOp;
+};
+
+/* Results of the benchmarked functions are accumulated here so the compiler can't discard the calls. */
+static volatile std::size_t sink;
+
+static const char* positions[]{
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1bn2/3p4/3P4/2NBPN2/PP3PPP/R2Q1RK1 b - - 5 11",
+    "2r3k1/5pp1/p3p2p/1p1nP3/3P4/P4N1P/1P3PP1/2R3K1 w - - 0 28",
+};
+
+/**
+ * @brief Times a function returning a value, calibrating the number of iterations so that each sample
+ * lasts long enough to be measured, and keeps the best of several samples.
+ *
+ * @param name The name of the benchmark
+ * @param operationsPerCall How many operations a single call of the function does
+ * @param function The benchmarked function
+ *
+ * @return The time per operation
+ */
+template<typename Function>
+static BenchmarkResult benchmark(const std::string& name, std::size_t operationsPerCall, Function function) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::chrono::milliseconds sampleDuration(20);
+    constexpr int sampleCount = 5;
+
+    std::size_t iterations = 1;
+    for(;;) {
+        const auto start = Clock::now();
+        for(std::size_t i = 0 ; i < iterations ; ++i) {
+            sink = sink + function();
+        }
+
+        if(Clock::now() - start >= sampleDuration || iterations >= (std::size_t(1) << 30)) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    double best = 0.0;
+    for(int sample = 0 ; sample < sampleCount ; ++sample) {
+        const auto start = Clock::now();
+        for(std::size_t i = 0 ; i < iterations ; ++i) {
+            sink = sink + function();
+        }
+
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        const double nsPerOp = elapsed.count() / double(iterations * operationsPerCall);
+
+        if(sample == 0 || nsPerOp < best) {
+            best = nsPerOp;
+        }
+    }
+
+    return BenchmarkResult{name, iterations * operationsPerCall, best};
+}
+
+/**
+ * @brief Benchmarks one of the ChessBoard::movesX functions from every square to every square of
+ * every position.
+ */
+static BenchmarkResult benchmarkMoves(const std::string& name, const std::vector<ChessBoard>& boards,
+                                      bool (ChessBoard::*moves)(const Point&, const Point&) const) {
+    return benchmark(name, boards.size() * 64 * 64, [&] {
+        std::size_t count = 0;
+
+        for(const ChessBoard& board: boards) {
+            for(int from = 0 ; from < 64 ; ++from) {
+                for(int to = 0 ; to < 64 ; ++to) {
+                    count += (board.*moves)(Point(from / 8, from % 8), Point(to / 8, to % 8));
+                }
+            }
+        }
+
+        return count;
+    });
+}
+
+static std::vector<BenchmarkResult> runBenchmarks() {
+    std::vector<BenchmarkResult> results;
+    std::vector<ChessBoard> boards(std::size(positions));
+
+    for(std::size_t i = 0 ; i < boards.size() ; ++i) {
+        boards[i].loadFEN(positions[i]);
+    }
+
+    /* testMoves is called on a board the piece was lifted from, like ChessGame does. */
+    struct LiftedPiece {
+        ChessBoard board;
+        ChessSquare piece;
+        Point from;
+    };
+
+    std::vector<LiftedPiece> liftedPieces;
+    for(const ChessBoard& board: boards) {
+        for(int x = 0 ; x < 8 ; ++x) {
+            for(int y = 0 ; y < 8 ; ++y) {
+                if(board[x][y].piece != ChessPieceNone && board[x][y].color == board.getTurn()) {
+                    LiftedPiece& lifted = liftedPieces.emplace_back(LiftedPiece{board, board[x][y], Point(x, y)});
+                    lifted.board[x][y] = ChessSquare(ChessPieceNone, ChessColorWhite);
+                }
+            }
+        }
+    }
+
+    results.push_back(benchmark("testMoves", liftedPieces.size() * 64, [&] {
+        std::size_t count = 0;
+
+        for(const LiftedPiece& lifted: liftedPieces) {
+            for(int to = 0 ; to < 64 ; ++to) {
+                count += lifted.board.testMoves(lifted.piece, lifted.from, Point(to / 8, to % 8));
+            }
+        }
+
+        return count;
+    }));
+
+    results.push_back(benchmarkMoves("movesKing", boards, &ChessBoard::movesKing));
+    results.push_back(benchmarkMoves("movesQueen", boards, &ChessBoard::movesQueen));
+    results.push_back(benchmarkMoves("movesBishop", boards, &ChessBoard::movesBishop));
+    results.push_back(benchmarkMoves("movesKnight", boards, &ChessBoard::movesKnight));
+    results.push_back(benchmarkMoves("movesRook", boards, &ChessBoard::movesRook));
+    results.push_back(benchmarkMoves("movesPawn", boards, &ChessBoard::movesPawn));
+
+    ChessBoard board;
+    results.push_back(benchmark("setStartingPosition", 1, [&] {
+        board.setStartingPosition();
+        return std::size_t(board[0][0].piece);
+    }));
+
+    results.push_back(benchmark("loadFEN", std::size(positions), [&] {
+        std::size_t count = 0;
+
+        for(const char* position: positions) {
+            board.loadFEN(position);
+            count += board.getTurn();
+        }
+
+        return count;
+    }));
+
+    /* renderCenteredText draws through an offscreen software renderer so no window is needed. */
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 800, 800, 32, SDL_PIXELFORMAT_RGBA32);
+    if(!surface) {
+        throw std::runtime_error(std::string("SDL_CreateRGBSurfaceWithFormat failed : ") + SDL_GetError());
+    }
+
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    if(!renderer) {
+        throw std::runtime_error(std::string("SDL_CreateSoftwareRenderer failed : ") + SDL_GetError());
+    }
+
+    TTF_Font* font = TTF_OpenFontRW(openAsset("fonts/courbd.ttf"), 1, 40);
+    if(!font) {
+        throw std::runtime_error(SDL_GetError());
+    }
+
+    const Rect rect(80, 16, 640, 48);
+    const Color color(59, 32, 18);
+    results.push_back(benchmark("renderCenteredText", 1, [&] {
+        renderCenteredText(renderer, font, rect, color, "It is White's turn !");
+        return std::size_t(SDL_RenderFlush(renderer) == 0);
+    }));
+
+    TTF_CloseFont(font);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+
+    return results;
+}
+
+static std::string toJSON(const std::vector<BenchmarkResult>& results) {
+    std::ostringstream json;
+    char nsPerOp[32];
+
+    json << "{\n  \"benchmarks\": [\n";
+    for(std::size_t i = 0 ; i < results.size() ; ++i) {
+        std::snprintf(nsPerOp, sizeof(nsPerOp), "%.4f", results[i].nsPerOp);
+
+        json << "    {\"name\": \"" << results[i].name << "\", \"iterations\": " << results[i].iterations
+             << ", \"ns_per_op\": " << nsPerOp << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    json << "  ]\n}\n";
+
+    return json.str();
+}
+
+/**
+ * @brief Reads the name and ns_per_op of every benchmark of a file written by toJSON.
+ */
+static std::unordered_map<std::string, double> readBaseline(std::istream& file) {
+    std::unordered_map<std::string, double> baseline;
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::string nameKey("\"name\": \""), timeKey("\"ns_per_op\": ");
+
+    for(std::size_t position = content.find(nameKey) ; position != std::string::npos ; position = content.find(nameKey, position)) {
+        position += nameKey.size();
+        const std::size_t nameEnd = content.find('"', position);
+        const std::size_t time = content.find(timeKey, nameEnd);
+
+        if(nameEnd == std::string::npos || time == std::string::npos) {
+            break;
+        }
+
+        baseline[content.substr(position, nameEnd - position)] = std::strtod(content.c_str() + time + timeKey.size(), nullptr);
+    }
+
+    return baseline;
+}
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage : " << name << " [--output file] [--baseline file] [--threshold percent] [--require-baseline]\n"
+              << "Prints the results as JSON (or writes them to file) and, given a baseline written by a\n"
+              << "previous run, exits with 1 if a benchmark got more than percent (default 10) slower.\n"
+              << "With --require-baseline, a missing baseline is an error instead of skipping the check.\n";
+}
+
+int main(int argc, char** argv) {
+    std::string outputPath, baselinePath;
+    double threshold = 10.0;
+    bool requireBaseline = false;
+
+    for(int i = 1 ; i < argc ; ++i) {
+        const std::string arg(argv[i]);
+
+        if(arg == "--require-baseline") {
+            requireBaseline = true;
+        } else if(i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 2;
+        } else if(arg == "--output") {
+            outputPath = argv[++i];
+        } else if(arg == "--baseline") {
+            baselinePath = argv[++i];
+        } else if(arg == "--threshold") {
+            threshold = std::strtod(argv[++i], nullptr);
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if(TTF_Init() != 0) {
+        std::cerr << "TTF_Init failed : " << SDL_GetError() << '\n';
+        return 2;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try {
+        results = runBenchmarks();
+    } catch(const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        TTF_Quit();
+        return 2;
+    }
+
+    TTF_Quit();
+
+    const std::string json = toJSON(results);
+    if(outputPath.empty()) {
+        std::cout << json;
+    } else {
+        const std::filesystem::path directory = std::filesystem::path(outputPath).parent_path();
+        std::error_code error;
+        if(!directory.empty()) {
+            std::filesystem::create_directories(directory, error);
+        }
+
+        std::ofstream output(outputPath);
+        if(!(output << json)) {
+            std::cerr << "Couldn't write '" << outputPath << "'\n";
+            return 2;
+        }
+    }
+
+    if(baselinePath.empty()) {
+        if(requireBaseline) {
+            std::cerr << "--require-baseline needs --baseline\n";
+            return 2;
+        }
+
+        return 0;
+    }
+
+    std::ifstream baselineFile(baselinePath);
+    if(!baselineFile) {
+        std::cerr << "No baseline at '" << baselinePath << "', record one with --output " << baselinePath << '\n';
+        return requireBaseline ? 2 : 0;
+    }
+
+    const std::unordered_map<std::string, double> baseline = readBaseline(baselineFile);
+    int regressions = 0;
+    char line[128];
+
+    for(const BenchmarkResult& result: results) {
+        const auto reference = baseline.find(result.name);
+        if(reference == baseline.end() || reference->second <= 0.0) {
+            std::snprintf(line, sizeof(line), "%-20s %12.4f ns/op  (not in baseline)", result.name.c_str(), result.nsPerOp);
+            std::cerr << line << '\n';
+            continue;
+        }
+
+        const double change = (result.nsPerOp / reference->second - 1.0) * 100.0;
+        const bool regressed = change > threshold;
+        regressions += regressed;
+
+        std::snprintf(line, sizeof(line), "%-20s %12.4f ns/op  %+7.1f%%%s", result.name.c_str(), result.nsPerOp, change,
+                      regressed ? "  REGRESSION" : "");
+        std::cerr << line << '\n';
+    }
+
+    if(regressions) {
+        std::cerr << regressions << " benchmark(s) got more than " << threshold << "% slower than the baseline\n";
+        return 1;
+    }
+
+    return 0;
+}
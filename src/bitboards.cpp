@@ -0,0 +1,75 @@
+/******************************************************************************************************
+ * @file  bitboards.cpp
+ * @brief Compile-time checks of the move and geometry tables
+ ******************************************************************************************************/
+
+#include "bitboards.hpp"
+
+/* Leapers */
+static_assert(std::popcount(kingAttacks[square(0, 0)]) == 3);
+static_assert(std::popcount(kingAttacks[square(0, 4)]) == 5);
+static_assert(std::popcount(kingAttacks[square(4, 4)]) == 8);
+static_assert(kingAttacks[square(7, 7)] == (squareMask(square(6, 6)) | squareMask(square(6, 7)) | squareMask(square(7, 6))));
+
+static_assert(std::popcount(knightAttacks[square(0, 0)]) == 2);
+static_assert(std::popcount(knightAttacks[square(7, 1)]) == 3);
+static_assert(std::popcount(knightAttacks[square(4, 4)]) == 8);
+static_assert(knightAttacks[square(0, 0)] == (squareMask(square(1, 2)) | squareMask(square(2, 1))));
+
+static_assert([] {
+    for(int from = 0 ; from < 64 ; ++from) {
+        for(int to = 0 ; to < 64 ; ++to) {
+            if(bool(kingAttacks[from] & squareMask(to)) != bool(kingAttacks[to] & squareMask(from))) { return false; }
+            if(bool(knightAttacks[from] & squareMask(to)) != bool(knightAttacks[to] & squareMask(from))) { return false; }
+        }
+    }
+    return true;
+}(), "leaper attacks must be symmetric");
+
+/* Pawns : white (0) moves towards row 0, black (1) towards row 7 */
+static_assert(pawnAttacks[0][square(6, 0)] == squareMask(square(5, 1)));
+static_assert(pawnAttacks[0][square(6, 4)] == (squareMask(square(5, 3)) | squareMask(square(5, 5))));
+static_assert(pawnAttacks[1][square(1, 7)] == squareMask(square(2, 6)));
+static_assert(pawnAttacks[0][square(0, 3)] == 0 && pawnAttacks[1][square(7, 3)] == 0);
+
+static_assert(pawnPushes[0][square(6, 2)] == squareMask(square(5, 2)));
+static_assert(pawnPushes[1][square(1, 2)] == squareMask(square(2, 2)));
+static_assert(pawnDoublePushes[0][square(6, 2)] == squareMask(square(4, 2)));
+static_assert(pawnDoublePushes[1][square(1, 2)] == squareMask(square(3, 2)));
+static_assert(pawnDoublePushes[0][square(5, 2)] == 0 && pawnDoublePushes[1][square(2, 2)] == 0);
+
+/* Sliders */
+static_assert([] {
+    for(int sq = 0 ; sq < 64 ; ++sq) {
+        if(std::popcount(rookMasks[sq]) != 14) { return false; }
+        if(bishopMasks[sq] & rookMasks[sq]) { return false; }
+        if((bishopMasks[sq] | rookMasks[sq]) & squareMask(sq)) { return false; }
+    }
+    return true;
+}(), "rook masks must hold 14 squares and never overlap bishop masks");
+
+static_assert(std::popcount(bishopMasks[square(0, 0)]) == 7);
+static_assert(std::popcount(bishopMasks[square(3, 3)]) == 13);
+static_assert(rays[7][square(0, 5)] == (squareMask(square(0, 6)) | squareMask(square(0, 7))));
+
+/* Between and line masks */
+static_assert(betweenMasks[square(0, 0)][square(7, 7)] == (bishopMasks[square(0, 0)] & ~squareMask(square(7, 7))));
+static_assert(std::popcount(betweenMasks[square(0, 0)][square(0, 7)]) == 6);
+static_assert(betweenMasks[square(3, 3)][square(3, 4)] == 0);
+static_assert(betweenMasks[square(0, 0)][square(1, 2)] == 0);
+static_assert(betweenMasks[square(4, 4)][square(4, 4)] == 0);
+
+static_assert(lineMasks[square(0, 0)][square(7, 7)] == lineMasks[square(3, 3)][square(5, 5)]);
+static_assert(std::popcount(lineMasks[square(2, 5)][square(2, 1)]) == 8);
+static_assert(lineMasks[square(0, 0)][square(1, 2)] == 0);
+
+static_assert([] {
+    for(int from = 0 ; from < 64 ; ++from) {
+        for(int to = 0 ; to < 64 ; ++to) {
+            if(betweenMasks[from][to] != betweenMasks[to][from] || lineMasks[from][to] != lineMasks[to][from]) { return false; }
+            if((betweenMasks[from][to] & ~lineMasks[from][to]) != 0) { return false; }
+            if(lineMasks[from][to] && !((bishopMasks[from] | rookMasks[from]) & squareMask(to))) { return false; }
+        }
+    }
+    return true;
+}(), "between and line masks must be symmetric and consistent with slider masks");
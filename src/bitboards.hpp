@@ -0,0 +1,213 @@
+/******************************************************************************************************
+ * @file  bitboards.hpp
+ * @brief Compile-time move and geometry tables for the chess board
+ ******************************************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * @brief A set of squares, one bit per square. Square (x, y) is bit x * 8 + y, where x is the row
+ * (0 being the top of the board, where the black pieces start) and y the column.
+ */
+using Bitboard = uint64_t;
+
+/**
+ * @brief Returns the index of the square at row x and column y.
+ */
+constexpr int square(int x, int y) {
+    return x * 8 + y;
+}
+
+/**
+ * @brief Returns whether row x and column y are on the board.
+ */
+constexpr bool isOnBoard(int x, int y) {
+    return x >= 0 && x < 8 && y >= 0 && y < 8;
+}
+
+/**
+ * @brief Returns a bitboard containing only the given square.
+ */
+constexpr Bitboard squareMask(int square) {
+    return Bitboard(1) << square;
+}
+
+/**
+ * @brief Returns the index of the first square of a non-empty bitboard.
+ */
+constexpr int firstSquare(Bitboard bitboard) {
+    return std::countr_zero(bitboard);
+}
+
+/**
+ * @brief An (x, y) offset on the board, usable at compile time unlike Point.
+ */
+struct Offset {
+    int x, y;
+};
+
+inline constexpr Offset kingOffsets[8]{{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+inline constexpr Offset knightOffsets[8]{{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+
+/**
+ * @brief The directions a sliding piece can move along. The first four are diagonals, the last four
+ * are orthogonals.
+ */
+inline constexpr Offset rayDirections[8]{{-1, -1}, {-1, 1}, {1, -1}, {1, 1}, {-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+namespace detail {
+    template<std::size_t N>
+    constexpr std::array<Bitboard, 64> generateLeaperAttacks(const Offset (& offsets)[N]) {
+        std::array<Bitboard, 64> attacks{};
+
+        for(int x = 0 ; x < 8 ; ++x) {
+            for(int y = 0 ; y < 8 ; ++y) {
+                for(const Offset& offset: offsets) {
+                    if(isOnBoard(x + offset.x, y + offset.y)) {
+                        attacks[square(x, y)] |= squareMask(square(x + offset.x, y + offset.y));
+                    }
+                }
+            }
+        }
+
+        return attacks;
+    }
+
+    constexpr std::array<std::array<Bitboard, 64>, 2> generatePawnAttacks() {
+        std::array<std::array<Bitboard, 64>, 2> attacks{};
+
+        for(int color = 0 ; color < 2 ; ++color) {
+            const int forward = color ? 1 : -1;
+
+            for(int x = 0 ; x < 8 ; ++x) {
+                for(int y = 0 ; y < 8 ; ++y) {
+                    for(int side = -1 ; side <= 1 ; side += 2) {
+                        if(isOnBoard(x + forward, y + side)) {
+                            attacks[color][square(x, y)] |= squareMask(square(x + forward, y + side));
+                        }
+                    }
+                }
+            }
+        }
+
+        return attacks;
+    }
+
+    constexpr std::array<std::array<Bitboard, 64>, 2> generatePawnPushes(int distance) {
+        std::array<std::array<Bitboard, 64>, 2> pushes{};
+
+        for(int color = 0 ; color < 2 ; ++color) {
+            const int forward = color ? distance : -distance;
+            const int startRow = color ? 1 : 6;
+
+            for(int x = 0 ; x < 8 ; ++x) {
+                for(int y = 0 ; y < 8 ; ++y) {
+                    if(isOnBoard(x + forward, y) && (distance == 1 || x == startRow)) {
+                        pushes[color][square(x, y)] = squareMask(square(x + forward, y));
+                    }
+                }
+            }
+        }
+
+        return pushes;
+    }
+
+    constexpr std::array<std::array<Bitboard, 64>, 8> generateRays() {
+        std::array<std::array<Bitboard, 64>, 8> rays{};
+
+        for(int direction = 0 ; direction < 8 ; ++direction) {
+            const Offset& offset = rayDirections[direction];
+
+            for(int x = 0 ; x < 8 ; ++x) {
+                for(int y = 0 ; y < 8 ; ++y) {
+                    for(int i = x + offset.x, j = y + offset.y ; isOnBoard(i, j) ; i += offset.x, j += offset.y) {
+                        rays[direction][square(x, y)] |= squareMask(square(i, j));
+                    }
+                }
+            }
+        }
+
+        return rays;
+    }
+
+    constexpr std::array<Bitboard, 64> combineRays(const std::array<std::array<Bitboard, 64>, 8>& rays, int first, int last) {
+        std::array<Bitboard, 64> masks{};
+
+        for(int sq = 0 ; sq < 64 ; ++sq) {
+            for(int direction = first ; direction < last ; ++direction) {
+                masks[sq] |= rays[direction][sq];
+            }
+        }
+
+        return masks;
+    }
+
+    /**
+     * @brief Generates the squares strictly between two squares when they share a line (both ends
+     * excluded) or the whole line going through them (both ends included), 0 otherwise.
+     */
+    constexpr std::array<std::array<Bitboard, 64>, 64> generateLines(bool between) {
+        std::array<std::array<Bitboard, 64>, 64> lines{};
+
+        for(int from = 0 ; from < 64 ; ++from) {
+            const int x = from / 8, y = from % 8;
+
+            for(const Offset& offset: rayDirections) {
+                Bitboard walked = 0;
+
+                for(int i = x + offset.x, j = y + offset.y ; isOnBoard(i, j) ; i += offset.x, j += offset.y) {
+                    if(between) {
+                        lines[from][square(i, j)] = walked;
+                    } else {
+                        Bitboard line = squareMask(from);
+                        for(int k = x + offset.x, l = y + offset.y ; isOnBoard(k, l) ; k += offset.x, l += offset.y) {
+                            line |= squareMask(square(k, l));
+                        }
+                        for(int k = x - offset.x, l = y - offset.y ; isOnBoard(k, l) ; k -= offset.x, l -= offset.y) {
+                            line |= squareMask(square(k, l));
+                        }
+                        lines[from][square(i, j)] = line;
+                    }
+
+                    walked |= squareMask(square(i, j));
+                }
+            }
+        }
+
+        return lines;
+    }
+}
+
+/// Squares a king can move to from each square.
+inline constexpr std::array<Bitboard, 64> kingAttacks = detail::generateLeaperAttacks(kingOffsets);
+
+/// Squares a knight can move to from each square.
+inline constexpr std::array<Bitboard, 64> knightAttacks = detail::generateLeaperAttacks(knightOffsets);
+
+/// Squares a pawn of each color attacks from each square, indexed by ChessColor then square.
+inline constexpr std::array<std::array<Bitboard, 64>, 2> pawnAttacks = detail::generatePawnAttacks();
+
+/// Square a pawn of each color moves to when it advances by one.
+inline constexpr std::array<std::array<Bitboard, 64>, 2> pawnPushes = detail::generatePawnPushes(1);
+
+/// Square a pawn of each color moves to when it advances by two, only set on its starting row.
+inline constexpr std::array<std::array<Bitboard, 64>, 2> pawnDoublePushes = detail::generatePawnPushes(2);
+
+/// Squares reached from each square in each of the rayDirections on an empty board.
+inline constexpr std::array<std::array<Bitboard, 64>, 8> rays = detail::generateRays();
+
+/// Squares a bishop reaches from each square on an empty board.
+inline constexpr std::array<Bitboard, 64> bishopMasks = detail::combineRays(rays, 0, 4);
+
+/// Squares a rook reaches from each square on an empty board.
+inline constexpr std::array<Bitboard, 64> rookMasks = detail::combineRays(rays, 4, 8);
+
+/// Squares strictly between two aligned squares, 0 when they aren't aligned.
+inline constexpr std::array<std::array<Bitboard, 64>, 64> betweenMasks = detail::generateLines(true);
+
+/// Whole line (edge to edge) going through two aligned squares, 0 when they aren't aligned.
+inline constexpr std::array<std::array<Bitboard, 64>, 64> lineMasks = detail::generateLines(false);
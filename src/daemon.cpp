@@ -0,0 +1,677 @@
+/******************************************************************************************************
+ * @file  daemon.cpp
+ * @brief Local analysis service answering batched requests over a Unix domain socket
+ *
+ * A client sends an operation line followed by one FEN per line and an empty line ending the batch:
+ *
+ *     moves | perft <depth> | eval | search <depth>
+ *     <fen>
+ *     ...
+ *     <empty line>
+ *
+ * Each position is answered as soon as a worker is done with it, so results can come out of order:
+ *
+ *     result <batch> <index> <answer>
+ *     done <batch> <positions> <latency in µs>
+ *
+ * where batch counts the batches sent on the connection. The single line "stats" is answered with
+ * the request latency and queue depth metrics.
+ *
+ * Every position is analysed with a bounded number of nodes: a search then answers with the depth it
+ * completed and a perft that doesn't fit answers with an error. The positions of a client that
+ * disconnects are abandoned.
+ ******************************************************************************************************/
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ChessBoard.hpp"
+#include "ChessEngine.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @enum Operation
+ * @brief The analyses a batch can ask for
+ */
+enum Operation : char {
+    OperationMoves,
+    OperationPerft,
+    OperationEval,
+    OperationSearch
+};
+
+/**
+ * @struct Job
+ * @brief One position of a batch, waiting for a worker
+ */
+struct Job {
+    uint64_t connection;
+    uint64_t batch;
+    std::size_t index;
+    Operation operation;
+    int depth;
+    std::string fen;
+    Clock::time_point queued;
+};
+
+/**
+ * @struct Completion
+ * @brief The answer to a job, waiting to be sent back by the event loop
+ */
+struct Completion {
+    uint64_t connection;
+    uint64_t batch;
+    std::string line;
+    Clock::time_point queued;
+};
+
+/**
+ * @struct Worker
+ * @brief A thread of the pool and the job it is running
+ */
+struct Worker {
+    std::thread thread;
+    std::atomic<bool> stop;     ///< Interrupts the running job
+    bool busy;                  ///< Guarded by the job mutex, like connection
+    uint64_t connection;
+};
+
+/**
+ * @struct PendingBatch
+ * @brief A batch some positions of which haven't been answered yet
+ */
+struct PendingBatch {
+    std::size_t answered, total;
+    bool complete;      ///< Whether the empty line ending the batch was received, total is only known then
+    Clock::time_point received;
+};
+
+/**
+ * @struct Connection
+ * @brief A client and the state of the batches it sent
+ */
+struct Connection {
+    int fd;
+    std::string input, output;
+    bool waitingForWrite;
+    bool inputClosed;   ///< The client shut its side down, the connection closes once every batch is answered
+
+    bool readingBatch;
+    Operation operation;
+    int depth;
+    std::size_t positions;
+    uint64_t batches;
+    std::unordered_map<uint64_t, PendingBatch> pending;
+};
+
+/**
+ * @class AnalysisService
+ * @brief Accepts clients and parses their batches on a single epoll thread, and hands positions to
+ * a pool of workers, each one reusing its own ChessEngine across requests.
+ */
+class AnalysisService {
+private:
+    static constexpr std::size_t maxLineLength = 1 << 16;
+    static constexpr int maxPerftDepth = 7;
+    static constexpr uint64_t maxNodes = 1'000'000;
+
+    int listenFd, epollFd, wakeFd, signalFd;
+
+    std::unordered_map<uint64_t, Connection> connections;
+    std::unordered_map<int, uint64_t> connectionIds;
+    uint64_t nextConnectionId;
+
+    std::mutex jobMutex;
+    std::condition_variable jobAvailable;
+    std::deque<Job> jobs;
+    bool stopping;
+
+    std::mutex completionMutex;
+    std::vector<Completion> completions;
+
+    std::deque<Worker> workers;
+
+    /* Metrics, only touched by the event loop. */
+    uint64_t answeredRequests, answeredBatches;
+    double totalLatency, maxLatency;
+    std::size_t maxQueueDepth;
+
+    void work(Worker& worker) {
+        ChessEngine engine;
+        ChessBoard board;
+        std::vector<ChessMove> moves;
+
+        engine.setNodeLimit(maxNodes);
+
+        for(;;) {
+            Job job;
+            {
+                std::unique_lock lock(jobMutex);
+                worker.busy = false;
+                jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+                if(jobs.empty()) {
+                    return;
+                }
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+
+                worker.busy = true;
+                worker.connection = job.connection;
+                worker.stop = false;
+            }
+
+            std::ostringstream line;
+            line << "result " << job.batch << ' ' << job.index << ' ';
+
+            try {
+                board.loadFEN(job.fen);
+
+                switch(job.operation) {
+                    case OperationMoves:
+                        moves.clear();
+                        board.generateLegalMoves(moves);
+
+                        line << "moves " << moves.size();
+                        for(const ChessMove& move: moves) {
+                            line << ' ' << move.toString();
+                        }
+                        break;
+                    case OperationPerft: {
+                        const uint64_t leaves = engine.perft(board, job.depth, &worker.stop);
+
+                        line << "perft " << leaves;
+                        break;
+                    }
+                    case OperationEval:
+                        line << "eval " << engine.evaluate(board);
+                        break;
+                    case OperationSearch: {
+                        const SearchResult result = engine.search(board, job.depth, &worker.stop);
+
+                        line << "search " << (result.hasMove ? result.bestMove.toString() : "none") << " score " << result.score
+                             << " depth " << result.depth << " nodes " << result.nodes;
+                        break;
+                    }
+                }
+            } catch(const std::exception& exception) {
+                line << "error " << exception.what();
+            }
+
+            line << '\n';
+
+            {
+                std::lock_guard lock(completionMutex);
+                completions.push_back(Completion{job.connection, job.batch, line.str(), job.queued});
+            }
+
+            const uint64_t one = 1;
+            if(write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+                std::cerr << "Couldn't wake the event loop : " << std::strerror(errno) << '\n';
+            }
+        }
+    }
+
+    void watch(int fd, uint32_t events, int operation) {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+
+        if(epoll_ctl(epollFd, operation, fd, &event) != 0) {
+            throw std::runtime_error(std::string("epoll_ctl failed : ") + std::strerror(errno));
+        }
+    }
+
+    void acceptClients() {
+        for(;;) {
+            const int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if(fd < 0) {
+                return;
+            }
+
+            const uint64_t id = nextConnectionId++;
+            connections[id] = Connection{fd, {}, {}, false, false, false, OperationMoves, 0, 0, 0, {}};
+            connectionIds[fd] = id;
+            watch(fd, EPOLLIN | EPOLLRDHUP, EPOLL_CTL_ADD);
+        }
+    }
+
+    void closeConnection(uint64_t id) {
+        const auto connection = connections.find(id);
+        if(connection == connections.end()) {
+            return;
+        }
+
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->second.fd, nullptr);
+        close(connection->second.fd);
+        connectionIds.erase(connection->second.fd);
+        connections.erase(connection);
+
+        /* Nobody is left to read the answers, the client's positions are abandoned. */
+        std::lock_guard lock(jobMutex);
+        std::erase_if(jobs, [id](const Job& job) { return job.connection == id; });
+
+        for(Worker& worker: workers) {
+            if(worker.busy && worker.connection == id) {
+                worker.stop = true;
+            }
+        }
+    }
+
+    void send(uint64_t id, const std::string& text) {
+        Connection& connection = connections.at(id);
+        const bool wasEmpty = connection.output.empty();
+
+        connection.output += text;
+        if(wasEmpty) {
+            flush(id);
+        }
+    }
+
+    void flush(uint64_t id) {
+        Connection& connection = connections.at(id);
+
+        while(!connection.output.empty()) {
+            const ssize_t written = ::send(connection.fd, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+
+            if(written < 0) {
+                if(errno != EAGAIN && errno != EWOULDBLOCK) {
+                    closeConnection(id);
+                } else if(!connection.waitingForWrite) {
+                    connection.waitingForWrite = true;
+                    updateEvents(connection);
+                }
+                return;
+            }
+
+            connection.output.erase(0, written);
+        }
+
+        if(connection.waitingForWrite) {
+            connection.waitingForWrite = false;
+            updateEvents(connection);
+        }
+
+        if(connection.inputClosed && connection.pending.empty()) {
+            closeConnection(id);
+        }
+    }
+
+    void updateEvents(const Connection& connection) {
+        const uint32_t readEvents = connection.inputClosed ? 0 : uint32_t(EPOLLIN | EPOLLRDHUP);
+        const uint32_t writeEvents = connection.waitingForWrite ? uint32_t(EPOLLOUT) : 0;
+
+        watch(connection.fd, readEvents | writeEvents, EPOLL_CTL_MOD);
+    }
+
+    std::string stats() {
+        std::size_t queueDepth;
+        {
+            std::lock_guard lock(jobMutex);
+            queueDepth = jobs.size();
+        }
+
+        std::ostringstream line;
+        line << "stats requests " << answeredRequests << " batches " << answeredBatches
+             << " queue " << queueDepth << " max_queue " << maxQueueDepth
+             << " latency_avg_us " << uint64_t(answeredRequests ? totalLatency / answeredRequests : 0.0)
+             << " latency_max_us " << uint64_t(maxLatency) << '\n';
+
+        return line.str();
+    }
+
+    void handleLine(uint64_t id, const std::string& line) {
+        Connection& connection = connections.at(id);
+
+        if(connection.readingBatch) {
+            if(!line.empty()) {
+                {
+                    std::lock_guard lock(jobMutex);
+                    jobs.push_back(Job{id, connection.batches, connection.positions++, connection.operation, connection.depth, line, Clock::now()});
+                    maxQueueDepth = std::max(maxQueueDepth, jobs.size());
+                }
+                jobAvailable.notify_one();
+                return;
+            }
+
+            const uint64_t batch = connection.batches++;
+            PendingBatch& pending = connection.pending.at(batch);
+
+            connection.readingBatch = false;
+            pending.total = connection.positions;
+            pending.complete = true;
+
+            completeBatchIfDone(id, batch);
+            return;
+        }
+
+        if(line.empty()) {
+            return;
+        }
+
+        std::istringstream words(line);
+        std::string operation;
+        int depth = 0;
+        words >> operation >> depth;
+
+        if(operation == "stats") {
+            send(id, stats());
+            return;
+        } else if(operation == "moves") {
+            connection.operation = OperationMoves;
+        } else if(operation == "eval") {
+            connection.operation = OperationEval;
+        } else if(operation == "perft" && depth > 0) {
+            connection.operation = OperationPerft;
+            depth = std::min(depth, maxPerftDepth);
+        } else if(operation == "search" && depth > 0) {
+            connection.operation = OperationSearch;
+            depth = std::min(depth, ChessEngine::maxDepth);
+        } else {
+            send(id, "error unknown operation '" + line + "'\n");
+            return;
+        }
+
+        connection.readingBatch = true;
+        connection.depth = depth;
+        connection.positions = 0;
+        connection.pending[connection.batches] = PendingBatch{0, 0, false, Clock::now()};
+    }
+
+    void completeBatchIfDone(uint64_t id, uint64_t batch) {
+        Connection& connection = connections.at(id);
+        const auto pending = connection.pending.find(batch);
+
+        if(pending == connection.pending.end() || !pending->second.complete || pending->second.answered != pending->second.total) {
+            return;
+        }
+
+        const std::chrono::duration<double, std::micro> latency = Clock::now() - pending->second.received;
+        const std::string line = "done " + std::to_string(batch) + ' ' + std::to_string(pending->second.total) + ' '
+                                 + std::to_string(uint64_t(latency.count())) + '\n';
+
+        connection.pending.erase(pending);
+        ++answeredBatches;
+
+        send(id, line);
+    }
+
+    void readClient(uint64_t id) {
+        char buffer[4096];
+
+        bool endOfInput = false;
+
+        for(;;) {
+            const ssize_t received = recv(connections.at(id).fd, buffer, sizeof(buffer), 0);
+
+            if(received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                closeConnection(id);
+                return;
+            } else if(received < 0) {
+                break;
+            } else if(received == 0) {
+                /* A last line without a newline and an unfinished batch are ended by the shutdown. */
+                endOfInput = true;
+                connections.at(id).input += "\n\n";
+                break;
+            }
+
+            connections.at(id).input.append(buffer, received);
+        }
+
+        for(;;) {
+            const auto connection = connections.find(id);
+            if(connection == connections.end()) {
+                return;
+            }
+
+            std::string& input = connection->second.input;
+            const std::size_t end = input.find('\n');
+
+            if(end == std::string::npos) {
+                if(input.size() > maxLineLength) {
+                    closeConnection(id);
+                } else if(endOfInput) {
+                    connection->second.inputClosed = true;
+                    updateEvents(connection->second);
+
+                    if(connection->second.pending.empty() && connection->second.output.empty()) {
+                        closeConnection(id);
+                    }
+                }
+                return;
+            }
+
+            std::string line = input.substr(0, end);
+            input.erase(0, end + 1);
+
+            if(!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            handleLine(id, line);
+        }
+    }
+
+    void deliverCompletions() {
+        uint64_t count;
+        while(read(wakeFd, &count, sizeof(count)) > 0) { }
+
+        std::vector<Completion> ready;
+        {
+            std::lock_guard lock(completionMutex);
+            ready.swap(completions);
+        }
+
+        const Clock::time_point now = Clock::now();
+
+        for(const Completion& completion: ready) {
+            const double latency = std::chrono::duration<double, std::micro>(now - completion.queued).count();
+            ++answeredRequests;
+            totalLatency += latency;
+            maxLatency = std::max(maxLatency, latency);
+
+            const auto connection = connections.find(completion.connection);
+            if(connection == connections.end()) {
+                continue;
+            }
+
+            const auto pending = connection->second.pending.find(completion.batch);
+            if(pending != connection->second.pending.end()) {
+                ++pending->second.answered;
+            }
+
+            send(completion.connection, completion.line);
+
+            if(connections.contains(completion.connection)) {
+                completeBatchIfDone(completion.connection, completion.batch);
+            }
+        }
+    }
+
+public:
+    AnalysisService(const std::string& path, unsigned int threadCount)
+        : listenFd(-1), epollFd(-1), wakeFd(-1), signalFd(-1), nextConnectionId(0), stopping(false),
+          answeredRequests(0), answeredBatches(0), totalLatency(0.0), maxLatency(0.0), maxQueueDepth(0) {
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if(path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Socket path too long : " + path);
+        }
+        std::strcpy(address.sun_path, path.c_str());
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(listenFd < 0) {
+            throw std::runtime_error(std::string("socket failed : ") + std::strerror(errno));
+        }
+
+        /* Only a socket left by a previous run is replaced. */
+        struct stat status;
+        if(lstat(path.c_str(), &status) == 0) {
+            if(!S_ISSOCK(status.st_mode)) {
+                throw std::runtime_error(path + " exists and isn't a socket");
+            }
+
+            unlink(path.c_str());
+        }
+
+        if(bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listenFd, 64) != 0) {
+            throw std::runtime_error("Couldn't listen on " + path + " : " + std::strerror(errno));
+        }
+
+        /* SIGINT and SIGTERM are blocked before the workers inherit the mask and read by the event loop. */
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+        if(epollFd < 0 || wakeFd < 0 || signalFd < 0) {
+            throw std::runtime_error(std::string("epoll_create1, eventfd or signalfd failed : ") + std::strerror(errno));
+        }
+
+        watch(listenFd, EPOLLIN, EPOLL_CTL_ADD);
+        watch(wakeFd, EPOLLIN, EPOLL_CTL_ADD);
+        watch(signalFd, EPOLLIN, EPOLL_CTL_ADD);
+
+        for(unsigned int i = 0 ; i < threadCount ; ++i) {
+            Worker& worker = workers.emplace_back();
+            worker.thread = std::thread(&AnalysisService::work, this, std::ref(worker));
+        }
+    }
+
+    ~AnalysisService() {
+        {
+            std::lock_guard lock(jobMutex);
+            stopping = true;
+            jobs.clear();
+
+            for(Worker& worker: workers) {
+                worker.stop = true;
+            }
+        }
+        jobAvailable.notify_all();
+
+        for(Worker& worker: workers) {
+            worker.thread.join();
+        }
+
+        while(!connections.empty()) {
+            closeConnection(connections.begin()->first);
+        }
+
+        close(signalFd);
+        close(wakeFd);
+        close(epollFd);
+        close(listenFd);
+    }
+
+    void run() {
+        epoll_event events[64];
+
+        for(;;) {
+            const int count = epoll_wait(epollFd, events, 64, -1);
+
+            if(count < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("epoll_wait failed : ") + std::strerror(errno));
+            }
+
+            for(int i = 0 ; i < count ; ++i) {
+                const int fd = events[i].data.fd;
+
+                if(fd == signalFd) {
+                    return;
+                } else if(fd == listenFd) {
+                    acceptClients();
+                } else if(fd == wakeFd) {
+                    deliverCompletions();
+                } else if(connectionIds.contains(fd)) {
+                    const uint64_t id = connectionIds.at(fd);
+
+                    if(events[i].events & EPOLLOUT) {
+                        flush(id);
+                    }
+
+                    const auto connection = connections.find(id);
+                    if(connection == connections.end()) {
+                        continue;
+                    }
+
+                    if(connection->second.inputClosed) {
+                        /* Hanging up after shutting the input down means nobody is left to read the answers. */
+                        if(events[i].events & (EPOLLHUP | EPOLLERR)) {
+                            closeConnection(id);
+                        }
+                    } else if(events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                        readClient(id);
+                    }
+                }
+            }
+        }
+    }
+};
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage : " << name << " [-j threads] [-s socket]\n";
+}
+
+int main(int argc, char** argv) {
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::string path("/tmp/chess.sock");
+
+    for(int i = 1 ; i < argc ; ++i) {
+        const std::string arg(argv[i]);
+
+        if(arg == "-j" && i + 1 < argc) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        } else if(arg == "-s" && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    try {
+        AnalysisService service(path, threadCount);
+        std::cout << "Listening on " << path << " with " << threadCount << " workers\n";
+        service.run();
+    } catch(const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        return 1;
+    }
+
+    unlink(path.c_str());
+    return 0;
+}
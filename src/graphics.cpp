@@ -6,6 +6,8 @@
 #include <stdexcept>
 #include "graphics.hpp"
 
+static const Uint64 startTime = SDL_GetPerformanceCounter();
+
 SDL_Texture* createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface, bool freeSurface) {
     if(!surface) {
         throw std::runtime_error{std::string("Surface wasn't defined (nullptr) : ") + SDL_GetError()};
@@ -18,7 +20,6 @@ SDL_Texture* createTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surfa
     }
 
     if(!texture) {
-        SDL_FreeSurface(surface);
         throw std::runtime_error{std::string("Couldn't create texture from surface. ") + SDL_GetError()};
     }
 
@@ -70,3 +71,14 @@ void renderCenteredText(SDL_Renderer* renderer, TTF_Font* font, const Rect& refe
     SDL_DestroyTexture(texture);
 }
 
+void logTimeToFirstFrame() {
+    static bool logged = false;
+    if(logged) {
+        return;
+    }
+
+    const double timeToFirstFrame = 1000.0 * (SDL_GetPerformanceCounter() - startTime) / SDL_GetPerformanceFrequency();
+    SDL_Log("Time to first frame : %.1f ms", timeToFirstFrame);
+    logged = true;
+}
+
@@ -56,4 +56,11 @@ void renderText(SDL_Renderer* renderer, TTF_Font* font, int x, int y, const Colo
  * @param color
  * @param text
  */
-void renderCenteredText(SDL_Renderer* renderer, TTF_Font* font, const Rect& reference, const Color& color, const std::string& text);
\ No newline at end of file
+void renderCenteredText(SDL_Renderer* renderer, TTF_Font* font, const Rect& reference, const Color& color, const std::string& text);
+
+/**
+ * @brief Logs how long the program took to show its first frame, measured from when it was loaded so
+ * that initialising SDL and decoding the piece images are included. Only the first call logs anything,
+ * it is meant to be called after every SDL_RenderPresent of the main loop.
+ */
+void logTimeToFirstFrame();
\ No newline at end of file
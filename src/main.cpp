@@ -1,7 +1,43 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "ChessEngine.hpp"
 #include "ChessGame.hpp"
+#include "ChessSimul.hpp"
 
-int main(int, char**) {
-    ChessGame chess(1500, 750);
+int main(int argc, char** argv) {
+    int simulGames = 0;
+    int engineDepth = 0;
+    bool ponder = false;
+
+    for(int i = 1 ; i < argc ; ++i) {
+        if(std::strcmp(argv[i], "--simul") == 0 && i + 1 < argc) {
+            simulGames = std::max(std::atoi(argv[++i]), 1);
+        } else if(std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            engineDepth = std::clamp(std::atoi(argv[++i]), 1, ChessEngine::maxDepth);
+        } else if(std::strcmp(argv[i], "--ponder") == 0) {
+            ponder = true;
+        } else {
+            std::cerr << "Usage : " << argv[0] << " [--simul games] [--engine depth] [--ponder]\n";
+            return 1;
+        }
+    }
+
+    if(simulGames > 0) {
+        ChessSimul simul(1500, 750, simulGames);
+
+        simul.run();
+
+        return 0;
+    }
+
+    /* Pondering without an engine opponent means playing against the default depth. */
+    if(ponder && engineDepth == 0) {
+        engineDepth = 5;
+    }
+
+    ChessGame chess(1500, 750, engineDepth, ponder);
 
     chess.run();
 
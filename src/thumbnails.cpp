@@ -0,0 +1,228 @@
+/******************************************************************************************************
+ * @file  thumbnails.cpp
+ * @brief Headless batch renderer turning FEN positions into PNG board images
+ ******************************************************************************************************/
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "BoardRenderer.hpp"
+#include "ChessBoard.hpp"
+
+/**
+ * @struct Position
+ * @brief A FEN position and the line of the input it was read from
+ */
+struct Position {
+    std::size_t line;   ///< Starting at 1
+    std::string fen;
+};
+
+/**
+ * @brief Renders positions to PNG files, each worker owning its own offscreen surface, software
+ * renderer and textures so that no SDL object is shared between threads.
+ */
+class ThumbnailRenderer {
+private:
+    const std::vector<Position>& positions;
+    const std::filesystem::path& directory;
+    const int size;
+
+    std::atomic<std::size_t> next;
+    std::atomic<std::size_t> rendered;
+    std::mutex errorMutex;
+
+    void reportError(const std::string& message) {
+        std::lock_guard lock(errorMutex);
+        std::cerr << message << '\n';
+    }
+
+    void work() {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+        if(!surface) {
+            reportError(std::string("SDL_CreateRGBSurfaceWithFormat failed : ") + SDL_GetError());
+            return;
+        }
+
+        SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+        if(!renderer) {
+            reportError(std::string("SDL_CreateSoftwareRenderer failed : ") + SDL_GetError());
+            SDL_FreeSurface(surface);
+            return;
+        }
+
+        try {
+            BoardRenderer boardRenderer(renderer, RGB(255, 225, 205), RGB(59, 32, 18));
+            boardRenderer.fitSurface(Rect(0, 0, size, size));
+
+            ChessBoard board;
+            char name[32];
+
+            for(std::size_t i = next++ ; i < positions.size() ; i = next++) {
+                const Position& position = positions[i];
+
+                try {
+                    board.loadFEN(position.fen);
+                } catch(const std::exception& exception) {
+                    reportError("Line " + std::to_string(position.line) + " : " + exception.what());
+                    continue;
+                }
+
+                SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255);
+                SDL_RenderClear(renderer);
+
+                boardRenderer.drawBoard();
+                boardRenderer.drawPieces(board);
+                boardRenderer.drawLettersAndNumbers();
+                SDL_RenderFlush(renderer);
+
+                std::snprintf(name, sizeof(name), "%06zu.png", position.line);
+                if(IMG_SavePNG(surface, (directory / name).string().c_str()) != 0) {
+                    reportError("Line " + std::to_string(position.line) + " : IMG_SavePNG failed : " + SDL_GetError());
+                    continue;
+                }
+
+                ++rendered;
+            }
+        } catch(const std::exception& exception) {
+            reportError(exception.what());
+        }
+
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(surface);
+    }
+
+public:
+    ThumbnailRenderer(const std::vector<Position>& positions, const std::filesystem::path& directory, int size)
+        : positions(positions), directory(directory), size(size), next(0), rendered(0) { }
+
+    /**
+     * @brief Renders every position using a pool of workers.
+     *
+     * @param threadCount The number of workers
+     *
+     * @return The number of images that were written
+     */
+    std::size_t run(unsigned int threadCount) {
+        std::vector<std::thread> workers;
+
+        for(unsigned int i = 0 ; i < threadCount ; ++i) {
+            workers.emplace_back(&ThumbnailRenderer::work, this);
+        }
+
+        for(std::thread& worker: workers) {
+            worker.join();
+        }
+
+        return rendered;
+    }
+};
+
+static void printUsage(const char* name) {
+    std::cerr << "Usage : " << name << " [-j threads] [-s size] [-o directory] [file]\n"
+              << "Renders every FEN position of file (or of the standard input), one per line, to\n"
+              << "directory/<line>.png, line being its line number padded to 6 digits (000001.png for the\n"
+              << "first line). Empty lines and lines starting with '#' are skipped.\n";
+}
+
+int main(int argc, char** argv) {
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    int size = 400;
+    std::filesystem::path directory("thumbnails");
+    std::string inputPath;
+
+    for(int i = 1 ; i < argc ; ++i) {
+        std::string arg(argv[i]);
+
+        if((arg == "-j" || arg == "-s" || arg == "-o") && i + 1 < argc) {
+            std::string value(argv[++i]);
+
+            try {
+                if(arg == "-j") {
+                    threadCount = std::max(1, std::stoi(value));
+                } else if(arg == "-s") {
+                    size = std::max(16, std::stoi(value));
+                } else {
+                    directory = value;
+                }
+            } catch(const std::exception&) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if(arg[0] != '-' && inputPath.empty()) {
+            inputPath = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::ifstream file;
+    if(!inputPath.empty()) {
+        file.open(inputPath);
+        if(!file) {
+            std::cerr << "Couldn't open '" << inputPath << "'\n";
+            return 1;
+        }
+    }
+
+    std::istream& input = inputPath.empty() ? std::cin : file;
+    std::vector<Position> positions;
+    std::string line;
+
+    for(std::size_t number = 1 ; std::getline(input, line) ; ++number) {
+        if(!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if(!line.empty() && line[0] != '#') {
+            positions.push_back(Position{number, line});
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if(error) {
+        std::cerr << "Couldn't create '" << directory.string() << "' : " << error.message() << '\n';
+        return 1;
+    }
+
+    if(IMG_Init(IMG_INIT_PNG) <= 0) {
+        std::cerr << "IMG_Init failed : " << SDL_GetError() << '\n';
+        return 1;
+    }
+
+    if(TTF_Init() != 0) {
+        std::cerr << "TTF_Init failed : " << SDL_GetError() << '\n';
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ThumbnailRenderer thumbnailRenderer(positions, directory, size);
+    const std::size_t rendered = thumbnailRenderer.run(threadCount);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Rendered " << rendered << '/' << positions.size() << " images with " << threadCount
+              << " threads in " << elapsed.count() << "s (" << rendered / elapsed.count() << " images/s)\n";
+
+    TTF_Quit();
+    IMG_Quit();
+
+    return rendered == positions.size() ? 0 : 1;
+}